@@ -0,0 +1,129 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+void Benchmark::writeCsv(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << "benchmark,instance,vertices,density,repetitions,calls_per_repetition,min_ns,median_ns,mean_ns,stddev_ns\n";
+    out << std::fixed << std::setprecision(3);
+    for (const BenchmarkResult& result : results) {
+        out << result.benchmark << ',' << result.instance << ',' << result.numberOfVertices << ',' << result.density << ','
+            << result.repetitions << ',' << result.callsPerRepetition << ',' << result.minimalNanoseconds << ','
+            << result.medianNanoseconds << ',' << result.meanNanoseconds << ',' << result.standardDeviationNanoseconds << '\n';
+    }
+}
+
+void Benchmark::writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    // Names of benchmarks and instances contain no characters that need escaping
+    out << std::fixed << std::setprecision(3);
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        out << "  {\"benchmark\": \"" << result.benchmark << "\", \"instance\": \"" << result.instance
+            << "\", \"vertices\": " << result.numberOfVertices << ", \"density\": " << result.density
+            << ", \"repetitions\": " << result.repetitions << ", \"calls_per_repetition\": " << result.callsPerRepetition
+            << ", \"min_ns\": " << result.minimalNanoseconds << ", \"median_ns\": " << result.medianNanoseconds
+            << ", \"mean_ns\": " << result.meanNanoseconds << ", \"stddev_ns\": " << result.standardDeviationNanoseconds << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
+
+std::vector<BenchmarkResult> Benchmark::readCsv(std::istream& in) {
+    std::vector<BenchmarkResult> results;
+    std::string line;
+    std::getline(in, line);  // header
+
+    while (std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::stringstream lineStream(line);
+        std::string field;
+        while (std::getline(lineStream, field, ',')) {
+            fields.push_back(field);
+        }
+        if (fields.size() != 10) {
+            std::cerr << "Error: Skipping malformed benchmark result: " << line << std::endl;
+            continue;
+        }
+
+        BenchmarkResult result;
+        result.benchmark = fields[0];
+        result.instance = fields[1];
+        result.numberOfVertices = std::stoi(fields[2]);
+        result.density = std::stod(fields[3]);
+        result.repetitions = std::stoi(fields[4]);
+        result.callsPerRepetition = std::stol(fields[5]);
+        result.minimalNanoseconds = std::stod(fields[6]);
+        result.medianNanoseconds = std::stod(fields[7]);
+        result.meanNanoseconds = std::stod(fields[8]);
+        result.standardDeviationNanoseconds = std::stod(fields[9]);
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<std::pair<BenchmarkResult, BenchmarkResult>> Benchmark::findRegressions(const std::vector<BenchmarkResult>& baseline,
+                                                                                    const std::vector<BenchmarkResult>& current,
+                                                                                    double tolerance) {
+    std::map<std::pair<std::string, std::string>, const BenchmarkResult*> baselineByName;
+    for (const BenchmarkResult& result : baseline) {
+        baselineByName[{result.benchmark, result.instance}] = &result;
+    }
+
+    // Benchmarks that are missing in the baseline are new and can't have regressed
+    std::vector<std::pair<BenchmarkResult, BenchmarkResult>> regressions;
+    for (const BenchmarkResult& result : current) {
+        auto it = baselineByName.find({result.benchmark, result.instance});
+        if (it != baselineByName.end() && result.medianNanoseconds > it->second->medianNanoseconds * (1 + tolerance)) {
+            regressions.emplace_back(*it->second, result);
+        }
+    }
+
+    return regressions;
+}
+
+BenchmarkResult Benchmark::summarize(const std::string& benchmark,
+                                     const std::string& instance,
+                                     int numberOfVertices,
+                                     double density,
+                                     long callsPerRepetition,
+                                     std::vector<double> nanosecondsPerCall) {
+    BenchmarkResult result;
+    result.benchmark = benchmark;
+    result.instance = instance;
+    result.numberOfVertices = numberOfVertices;
+    result.density = density;
+    result.repetitions = nanosecondsPerCall.size();
+    result.callsPerRepetition = callsPerRepetition;
+
+    if (nanosecondsPerCall.empty()) {
+        return result;
+    }
+
+    std::sort(nanosecondsPerCall.begin(), nanosecondsPerCall.end());
+    size_t middle = nanosecondsPerCall.size() / 2;
+    result.minimalNanoseconds = nanosecondsPerCall.front();
+    result.medianNanoseconds = nanosecondsPerCall.size() % 2 == 1 ? nanosecondsPerCall[middle]
+                                                                   : (nanosecondsPerCall[middle - 1] + nanosecondsPerCall[middle]) / 2;
+    result.meanNanoseconds = std::accumulate(nanosecondsPerCall.begin(), nanosecondsPerCall.end(), 0.0) / nanosecondsPerCall.size();
+
+    double sumOfSquaredDeviations = 0;
+    for (double nanoseconds : nanosecondsPerCall) {
+        sumOfSquaredDeviations += (nanoseconds - result.meanNanoseconds) * (nanoseconds - result.meanNanoseconds);
+    }
+    result.standardDeviationNanoseconds = std::sqrt(sumOfSquaredDeviations / nanosecondsPerCall.size());
+
+    return result;
+}
@@ -0,0 +1,103 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Timer.h"
+
+struct BenchmarkSettings {
+    int warmupRepetitions = 2;
+    int repetitions = 10;
+
+    // Every repetition calls the kernel often enough to take at least this long, so that the resolution of the clock doesn't matter
+    double minimalRepetitionSeconds = 0.02;
+};
+
+// Times are given per call of the kernel
+struct BenchmarkResult {
+    std::string benchmark;
+    std::string instance;
+    int numberOfVertices = 0;
+    double density = 0;
+    int repetitions = 0;
+    long callsPerRepetition = 0;
+    double minimalNanoseconds = 0;
+    double medianNanoseconds = 0;
+    double meanNanoseconds = 0;
+    double standardDeviationNanoseconds = 0;
+};
+
+class Benchmark {
+   public:
+    // Keeps the compiler from removing the computation of a value that is not used otherwise
+    template <typename T>
+    static void doNotOptimizeAway(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // Finds the number of calls per repetition, warms up and measures the given number of repetitions
+    template <typename Kernel>
+    static BenchmarkResult run(const std::string& benchmark,
+                               const std::string& instance,
+                               int numberOfVertices,
+                               double density,
+                               const BenchmarkSettings& settings,
+                               Kernel&& kernel) {
+        auto callRepeatedly = [&kernel](long numberOfCalls) {
+            return measureExecutionTime([&]() {
+                for (long call = 0; call < numberOfCalls; ++call) {
+                    if constexpr (std::is_void_v<decltype(kernel())>) {
+                        kernel();
+                    } else {
+                        doNotOptimizeAway(kernel());
+                    }
+                }
+            });
+        };
+
+        // The calibration also warms up the caches and the branch predictors
+        long callsPerRepetition = 1;
+        while (callRepeatedly(callsPerRepetition) < settings.minimalRepetitionSeconds) {
+            callsPerRepetition *= 2;
+        }
+
+        for (int repetition = 0; repetition < settings.warmupRepetitions; ++repetition) {
+            callRepeatedly(callsPerRepetition);
+        }
+
+        std::vector<double> nanosecondsPerCall(settings.repetitions);
+        for (double& nanoseconds : nanosecondsPerCall) {
+            nanoseconds = callRepeatedly(callsPerRepetition) * 1e9 / callsPerRepetition;
+        }
+
+        return summarize(benchmark, instance, numberOfVertices, density, callsPerRepetition, nanosecondsPerCall);
+    }
+
+    static void writeCsv(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+    static void writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+    // Reads results written by writeCsv, e.g. of an earlier build to compare with
+    static std::vector<BenchmarkResult> readCsv(std::istream& in);
+
+    // Pairs of (baseline, current) results whose median got slower by more than the tolerance, e.g. 0.1 for 10%
+    static std::vector<std::pair<BenchmarkResult, BenchmarkResult>> findRegressions(
+        const std::vector<BenchmarkResult>& baseline,
+        const std::vector<BenchmarkResult>& current,
+        double tolerance);
+
+   private:
+    static BenchmarkResult summarize(
+        const std::string& benchmark,
+        const std::string& instance,
+        int numberOfVertices,
+        double density,
+        long callsPerRepetition,
+        std::vector<double> nanosecondsPerCall);
+};
+
+#endif  // BENCHMARK_H
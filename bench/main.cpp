@@ -0,0 +1,320 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Benchmark.h"
+#include "FileReading.h"
+#include "FixedSetSearch.h"
+#include "GreedyAdding.h"
+#include "GreedyMoving.h"
+#include "InstanceGenerator.h"
+#include "Partition.h"
+#include "PartitionDistances.h"
+#include "RandomNumberGenerator.h"
+#include "SimulatedAnnealing.h"
+#include "SolutionClass.h"
+#include "SolutionManager.h"
+
+namespace {
+
+struct BenchmarkInstance {
+    std::string name;
+    int numberOfVertices;
+    double density;
+    std::vector<int> vertices;
+    std::vector<std::vector<int>> weights;
+    std::unique_ptr<InstanceGenerator> generator;
+};
+
+// Uniform random weights in [-100, 100] like the random instances of CP-Lib, see InstanceGenerator
+BenchmarkInstance generateInstance(int numberOfVertices, double density, uint64_t seed) {
+    BenchmarkInstance instance;
+    std::ostringstream name;
+    name << "n" << numberOfVertices << "_d" << density;
+    instance.name = name.str();
+    instance.numberOfVertices = numberOfVertices;
+    instance.density = density;
+
+    InstanceGenerator::Options generatorOptions;
+    generatorOptions.numberOfVertices = numberOfVertices;
+    generatorOptions.density = density;
+    generatorOptions.seed = seed;
+    instance.generator = std::make_unique<InstanceGenerator>(generatorOptions);
+    std::tie(instance.vertices, instance.weights) = instance.generator->generate();
+
+    return instance;
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+struct Options {
+    BenchmarkSettings settings;
+    std::vector<int> sizes = {100, 300, 1000};
+    std::vector<double> densities = {1.0, 0.2};
+    std::string filter;
+    std::string format = "json";
+    std::string outputFileName;
+    std::string baselineFileName;
+    double tolerance = 0.1;
+    uint64_t seed = 1;
+};
+
+void printUsage() {
+    std::cerr << "Usage: fss_bench [options]\n"
+              << "  --sizes 100,300,1000   numbers of vertices of the generated instances\n"
+              << "  --densities 1,0.2      portions of the vertex pairs with a non-zero weight\n"
+              << "  --filter TEXT          only run the benchmarks whose name contains TEXT\n"
+              << "  --repetitions N        measured repetitions per benchmark (default 10)\n"
+              << "  --warmup N             repetitions before measuring (default 2)\n"
+              << "  --min-time SECONDS     minimal duration of a repetition (default 0.02)\n"
+              << "  --seed N               seed of the instances and the solver (default 1)\n"
+              << "  --format json|csv      output format (default json)\n"
+              << "  --output FILE          write the results to FILE instead of stdout\n"
+              << "  --baseline FILE        CSV of an earlier run, exits with 1 if a median got slower\n"
+              << "  --tolerance RATIO      allowed slowdown against the baseline (default 0.1)\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Error: Missing value for " << argument << std::endl;
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (argument == "--sizes") {
+            options.sizes.clear();
+            for (const std::string& size : splitList(value)) {
+                options.sizes.push_back(std::stoi(size));
+            }
+        } else if (argument == "--densities") {
+            options.densities.clear();
+            for (const std::string& density : splitList(value)) {
+                options.densities.push_back(std::stod(density));
+            }
+        } else if (argument == "--filter") {
+            options.filter = value;
+        } else if (argument == "--repetitions") {
+            options.settings.repetitions = std::stoi(value);
+        } else if (argument == "--warmup") {
+            options.settings.warmupRepetitions = std::stoi(value);
+        } else if (argument == "--min-time") {
+            options.settings.minimalRepetitionSeconds = std::stod(value);
+        } else if (argument == "--seed") {
+            options.seed = std::stoull(value);
+        } else if (argument == "--format" && (value == "json" || value == "csv")) {
+            options.format = value;
+        } else if (argument == "--output") {
+            options.outputFileName = value;
+        } else if (argument == "--baseline") {
+            options.baselineFileName = value;
+        } else if (argument == "--tolerance") {
+            options.tolerance = std::stod(value);
+        } else {
+            std::cerr << "Error: Unknown option " << argument << " " << value << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Runs all benchmarks on one instance. The solutions the kernels start from are computed with a fixed seed,
+// so that every build measures the same work.
+void benchmarkInstance(const BenchmarkInstance& instance, const Options& options, std::vector<BenchmarkResult>& results) {
+    const std::vector<int>& vertices = instance.vertices;
+    const std::vector<std::vector<int>>& weights = instance.weights;
+    int numberOfVertices = instance.numberOfVertices;
+
+    RandomNumberGenerator::ScopedSeed scopedSeed(options.seed);
+
+    // Local optima as they are found by the GRASP, to start the kernels from realistic partitions
+    const int numberOfSolutions = 10;
+    std::vector<SharedSolution> solutions;
+    for (int i = 0; i < numberOfSolutions; ++i) {
+        Partition partition = GreedyAdding::runForEmptyPartition(vertices, weights, 2);
+        partition = GreedyMoving::run(vertices, weights, partition);
+        partition.relabelInFirstOccurrenceOrder();
+        solutions.push_back(std::make_shared<const SolutionWithValueAndIndexLookup>(partition, weights));
+    }
+    const Partition& localOptimum = solutions[0]->partition;
+
+    auto runBenchmark = [&](const std::string& benchmark, auto&& kernel) {
+        if (benchmark.find(options.filter) == std::string::npos) {
+            return;
+        }
+        std::cerr << "Running " << benchmark << " on " << instance.name << std::endl;
+        results.push_back(Benchmark::run(benchmark, instance.name, numberOfVertices, instance.density, options.settings, kernel));
+    };
+
+    {
+        // Low enough that the annealing stays close to the local optimum, as at the end of a run
+        const double temperature = 10;
+        int numberOfCliques = localOptimum.numberOfCliques();
+        std::vector<int> numberOfVerticesInCliques = SimulatedAnnealing::initializeNumberOfVerticesInCliques(localOptimum, numberOfVertices);
+        std::vector<std::vector<int>> benefitOfMoving = SimulatedAnnealing::initializeEdgeWeightSumsBetweenVertexAndClique(vertices, weights, localOptimum, numberOfCliques);
+        std::vector<int> cliqueIndexForVertex = SimulatedAnnealing::initializeCliqueIndexForVertexLookup(localOptimum, numberOfVertices);
+        int vertexMovedPreviously = 0;
+
+        runBenchmark("SimulatedAnnealing::step", [&]() {
+            auto [performedTransition, reward, vertexMoved] = SimulatedAnnealing::step(numberOfVerticesInCliques, vertices, weights, benefitOfMoving,
+                                                                                      cliqueIndexForVertex, vertexMovedPreviously, temperature);
+            vertexMovedPreviously = vertexMoved;
+            return performedTransition;
+        });
+    }
+
+    {
+        // Moves the vertices one after another into the next clique, which keeps the sums consistent
+        int numberOfCliques = localOptimum.numberOfCliques();
+        std::vector<std::vector<int>> benefitOfMoving = SimulatedAnnealing::initializeEdgeWeightSumsBetweenVertexAndClique(vertices, weights, localOptimum, numberOfCliques);
+        std::vector<int> cliqueIndexForVertex = SimulatedAnnealing::initializeCliqueIndexForVertexLookup(localOptimum, numberOfVertices);
+        int vertex = 0;
+
+        runBenchmark("SimulatedAnnealing::updateEdgeWeightSumsBetweenVertexAndClique", [&]() {
+            int oldCliqueIndex = cliqueIndexForVertex[vertex];
+            int newCliqueIndex = (oldCliqueIndex + 1) % numberOfCliques;
+            SimulatedAnnealing::updateEdgeWeightSumsBetweenVertexAndClique(weights, benefitOfMoving, vertex, oldCliqueIndex, newCliqueIndex);
+            cliqueIndexForVertex[vertex] = newCliqueIndex;
+            vertex = (vertex + 1) % numberOfVertices;
+        });
+    }
+
+    runBenchmark("GreedyAdding::run", [&]() {
+        return GreedyAdding::run(vertices, weights, Partition(numberOfVertices), 2).numberOfCliques();
+    });
+
+    {
+        // Starts from the partition of the GreedyAdding, before it was improved
+        Partition partition = GreedyAdding::runForEmptyPartition(vertices, weights, 2);
+
+        runBenchmark("GreedyMoving::run", [&]() {
+            return GreedyMoving::run(vertices, weights, partition).numberOfCliques();
+        });
+    }
+
+    runBenchmark("FixedSetSearch::findFixedPartialSolution", [&]() {
+        return FixedSetSearch::findFixedPartialSolution(localOptimum, solutions, 0.5).numberOfCliques();
+    });
+
+    {
+        // Two different local optima, which are far apart, and a local optimum with a few moved vertices, which is similar
+        const std::vector<int>& far = solutions[1]->cliqueIndexForVertexLookup();
+        std::vector<int> nearLookup = localOptimum.cliqueIndexForVertexLookup();
+        for (int vertex = 0; vertex < numberOfVertices; vertex += 100) {
+            nearLookup[vertex] = (nearLookup[vertex] + 1) % localOptimum.numberOfCliques();
+        }
+        Partition near(nearLookup);
+
+        runBenchmark("randError", [&]() {
+            return randError(localOptimum.cliqueIndexForVertexLookup(), far);
+        });
+        runBenchmark("isRandErrorBelow/far", [&]() {
+            return isRandErrorBelow(localOptimum, solutions[1]->partition, 0.02);
+        });
+        runBenchmark("isRandErrorBelow/near", [&]() {
+            return isRandErrorBelow(localOptimum, near, 0.02);
+        });
+
+        // The pool of the DPS filled with the local optima, and another local optimum as the far candidate.
+        // The manager keeps the comparisons with the last candidate, so two copies of each candidate take turns.
+        SolutionManager solutionManager;
+        solutionManager.initialize(solutions);
+        Partition farPartition = GreedyAdding::runForEmptyPartition(vertices, weights, 2);
+        farPartition = GreedyMoving::run(vertices, weights, farPartition);
+        farPartition.relabelInFirstOccurrenceOrder();
+        SolutionWithValueAndIndexLookup nearCandidates[2] = {{near, weights}, {near, weights}};
+        SolutionWithValueAndIndexLookup farCandidates[2] = {{farPartition, weights}, {farPartition, weights}};
+        int candidateIndex = 0;
+
+        runBenchmark("SolutionManager::existsSimilarSolutionWithHigherValue/far", [&]() {
+            candidateIndex = 1 - candidateIndex;
+            return solutionManager.existsSimilarSolutionWithHigherValue(farCandidates[candidateIndex]);
+        });
+        runBenchmark("SolutionManager::existsSimilarSolutionWithHigherValue/near", [&]() {
+            candidateIndex = 1 - candidateIndex;
+            return solutionManager.existsSimilarSolutionWithHigherValue(nearCandidates[candidateIndex]);
+        });
+    }
+
+    {
+        std::string filename = (std::filesystem::temp_directory_path() / ("fss_bench_" + instance.name + ".txt")).string();
+        instance.generator->writeToFile(filename);
+
+        runBenchmark("FileReading::readProblemFromFile", [&]() {
+            return FileReading::readProblemFromFile(filename).first.size();
+        });
+
+        std::remove(filename.c_str());
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (int numberOfVertices : options.sizes) {
+        for (double density : options.densities) {
+            BenchmarkInstance instance = generateInstance(numberOfVertices, density, options.seed);
+            benchmarkInstance(instance, options, results);
+        }
+    }
+
+    std::ofstream outputFile;
+    if (!options.outputFileName.empty()) {
+        outputFile.open(options.outputFileName);
+        if (!outputFile.is_open()) {
+            std::cerr << "Error: Could not open the output file." << std::endl;
+            return 2;
+        }
+    }
+    std::ostream& out = options.outputFileName.empty() ? std::cout : outputFile;
+
+    if (options.format == "csv") {
+        Benchmark::writeCsv(out, results);
+    } else {
+        Benchmark::writeJson(out, results);
+    }
+
+    if (options.baselineFileName.empty()) {
+        return 0;
+    }
+
+    std::ifstream baselineFile(options.baselineFileName);
+    if (!baselineFile.is_open()) {
+        std::cerr << "Error: Could not open the baseline file." << std::endl;
+        return 2;
+    }
+
+    auto regressions = Benchmark::findRegressions(Benchmark::readCsv(baselineFile), results, options.tolerance);
+    for (const auto& [baseline, current] : regressions) {
+        std::cerr << "Regression: " << current.benchmark << " on " << current.instance << " took " << current.medianNanoseconds
+                  << " ns instead of " << baseline.medianNanoseconds << " ns" << std::endl;
+    }
+
+    return regressions.empty() ? 0 : 1;
+}
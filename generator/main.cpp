@@ -0,0 +1,110 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "InstanceGenerator.h"
+
+namespace {
+
+void printUsage() {
+    std::cerr << "Usage: fss_generate --output FILE [options]\n"
+              << "  --output FILE          instance in CPn format\n"
+              << "  --variant NAME         uniform, planted, geometric or sparse (default uniform)\n"
+              << "  --vertices N           number of vertices (default 100)\n"
+              << "  --density D            portion of the pairs with a non-zero weight (default 1)\n"
+              << "  --min-weight W         smallest weight (default -100)\n"
+              << "  --max-weight W         largest weight (default 100)\n"
+              << "  --seed N               the same seed always gives the same instance (default 1)\n"
+              << "  --clusters K           planted: number of clusters (default 10)\n"
+              << "  --noise P              planted: probability that a weight has the wrong sign (default 0.1)\n"
+              << "  --radius R             geometric: distance below which weights are positive (default 0.2)\n"
+              << "  --degree D             sparse: average number of non-zero weights per vertex (default 10)\n"
+              << "  --planted-partition FILE  planted: writes the cluster of each vertex, one per line\n";
+}
+
+bool parseOptions(int argc, char* argv[], InstanceGenerator::Options& options, std::string& outputFileName, std::string& partitionFileName) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Error: Missing value for " << argument << std::endl;
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (argument == "--output") {
+            outputFileName = value;
+        } else if (argument == "--variant") {
+            if (!InstanceGenerator::parseVariant(value, options.variant)) {
+                std::cerr << "Error: Unknown variant " << value << std::endl;
+                return false;
+            }
+        } else if (argument == "--vertices") {
+            options.numberOfVertices = std::stoi(value);
+        } else if (argument == "--density") {
+            options.density = std::stod(value);
+        } else if (argument == "--min-weight") {
+            options.minimalWeight = std::stoi(value);
+        } else if (argument == "--max-weight") {
+            options.maximalWeight = std::stoi(value);
+        } else if (argument == "--seed") {
+            options.seed = std::stoull(value);
+        } else if (argument == "--clusters") {
+            options.numberOfClusters = std::stoi(value);
+        } else if (argument == "--noise") {
+            options.noise = std::stod(value);
+        } else if (argument == "--radius") {
+            options.radius = std::stod(value);
+        } else if (argument == "--degree") {
+            options.averageDegree = std::stod(value);
+        } else if (argument == "--planted-partition") {
+            partitionFileName = value;
+        } else {
+            std::cerr << "Error: Unknown option " << argument << " " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (outputFileName.empty()) {
+        std::cerr << "Error: No output file given." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    InstanceGenerator::Options options;
+    std::string outputFileName;
+    std::string partitionFileName;
+    if (!parseOptions(argc, argv, options, outputFileName, partitionFileName)) {
+        printUsage();
+        return 2;
+    }
+
+    InstanceGenerator generator(options);
+    if (!generator.writeToFile(outputFileName)) {
+        return 1;
+    }
+
+    if (!partitionFileName.empty()) {
+        if (options.variant != InstanceGenerator::PLANTED_PARTITION) {
+            std::cerr << "Error: Only the planted variant has a planted partition." << std::endl;
+            return 1;
+        }
+
+        std::ofstream partitionFile(partitionFileName);
+        if (!partitionFile.is_open()) {
+            std::cerr << "Error: Could not open " << partitionFileName << std::endl;
+            return 1;
+        }
+        for (int vertex = 0; vertex < generator.numberOfVertices(); ++vertex) {
+            partitionFile << generator.plantedCliqueIndexForVertex(vertex) << "\n";
+        }
+    }
+
+    return 0;
+}
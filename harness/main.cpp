@@ -0,0 +1,451 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CancellationToken.h"
+#include "DiversePoolSearch.h"
+#include "FileReading.h"
+#include "FixedSetSearch.h"
+#include "Partition.h"
+#include "PortionScheduler.h"
+#include "RandomNumberGenerator.h"
+#include "SearchProgress.h"
+#include "SimulatedAnnealing.h"
+#include "utils.h"
+
+namespace {
+
+// Switches of the search variants, which are the same for all runs of the harness
+struct SearchVariants {
+    bool contractFixedCliques = FixedSetSearch::contractFixedCliques;
+    bool annealOnlyFreeVertices = FixedSetSearch::annealOnlyFreeVertices;
+    double relaxationTemperatureFactor = FixedSetSearch::relaxationTemperatureFactor;
+    bool pipelinedIterations = FixedSetSearch::pipelinedIterations;
+    PortionScheduler::Strategy portionSchedulingStrategy = FixedSetSearch::portionSchedulingStrategy;
+    bool parallelPoolSweep = DiversePoolSearch::parallelPoolSweep;
+    int numberOfSpeculativeReheats = DiversePoolSearch::numberOfSpeculativeReheats;
+
+    void apply() const {
+        FixedSetSearch::contractFixedCliques = contractFixedCliques;
+        FixedSetSearch::annealOnlyFreeVertices = annealOnlyFreeVertices;
+        FixedSetSearch::relaxationTemperatureFactor = relaxationTemperatureFactor;
+        FixedSetSearch::pipelinedIterations = pipelinedIterations;
+        FixedSetSearch::portionSchedulingStrategy = portionSchedulingStrategy;
+        DiversePoolSearch::parallelPoolSweep = parallelPoolSweep;
+        DiversePoolSearch::numberOfSpeculativeReheats = numberOfSpeculativeReheats;
+    }
+
+    std::string portionSchedulingStrategyName() const {
+        return portionSchedulingStrategy == PortionScheduler::UPPER_CONFIDENCE_BOUND ? "ucb" : "round-robin";
+    }
+};
+
+struct Options {
+    std::string instanceDirectory;
+    std::vector<std::string> algorithms = {"fss", "dps"};
+    std::vector<uint64_t> seeds = {1};
+    std::vector<int> threadCounts = {1};
+    std::optional<int> target;
+    std::string targetsFileName;
+    double timeLimitInSeconds = 60;
+    int numberOfTotalIterations = 1'000'000;
+    double batchSizeScaleFactor = 8;
+    std::string csvFileName;
+    std::string traceCsvFileName;
+    std::string jsonFileName;
+    bool verbose = false;
+    SearchVariants variants;
+};
+
+struct RunResult {
+    std::string instance;
+    std::string algorithm;
+    uint64_t seed;
+    int numberOfThreads;
+    std::optional<int> target;
+    SearchVariants variants;
+
+    // Unset if the target was not reached before the deadline
+    std::optional<double> timeToTarget;
+
+    int bestValue = 0;
+    double seconds = 0;
+    int completedIterations = 0;
+    double iterationsPerSecond = 0;
+    std::vector<SearchProgress> bestValueOverTime;
+
+    // FSS: each portion of fixed vertices with its statistics
+    std::vector<std::pair<double, PortionScheduler::PortionStatistics>> portionStatistics;
+};
+
+// Swallows the output of the solver, so that it doesn't mix with the results
+class NullBuffer : public std::streambuf {
+   protected:
+    int overflow(int c) override {
+        return c;
+    }
+};
+
+template <typename T, typename Parse>
+std::vector<T> parseList(const std::string& list, Parse parse) {
+    std::vector<T> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        items.push_back(parse(item));
+    }
+    return items;
+}
+
+void printUsage() {
+    std::cerr << "Usage: fss_harness --instances DIR [options]\n"
+              << "  --instances DIR        directory with the instances in CPn format\n"
+              << "  --algorithms fss,dps   searches to run (default both)\n"
+              << "  --seeds 1,2,3          seeds of the runs (default 1)\n"
+              << "  --threads 1,4          numbers of threads (default 1)\n"
+              << "  --target VALUE         stop a run once its best value reaches VALUE\n"
+              << "  --targets FILE         lines of 'instance_file_name value', overrides --target for these instances\n"
+              << "  --time-limit SECONDS   deadline of each run (default 60)\n"
+              << "  --iterations N         maximal number of iterations of each run (default 1000000)\n"
+              << "  --csv FILE             summary of every run (default: stdout)\n"
+              << "  --trace-csv FILE       best value over time of every run\n"
+              << "  --json FILE            summary and best value over time of every run\n"
+              << "  --verbose              keep the output of the searches\n"
+              << "Search variants, recorded with every run:\n"
+              << "  --contract             FSS: contract the fixed cliques\n"
+              << "  --anneal-free          FSS: only anneal the vertices that are not fixed\n"
+              << "  --relaxation-factor F  FSS: temperature factor of the relaxation after --anneal-free (default 0.1)\n"
+              << "  --pipelined            FSS: prepare the next iterations while annealing\n"
+              << "  --portion-strategy S   FSS: round-robin or ucb (default round-robin)\n"
+              << "  --parallel-sweep       DPS: improve all solutions of the pool at the same time\n"
+              << "  --speculative-reheats N  DPS: reheated annealing runs started at once (default 1)\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help") {
+            return false;
+        }
+        if (argument == "--verbose" || argument == "--contract" || argument == "--anneal-free" || argument == "--pipelined" ||
+            argument == "--parallel-sweep") {
+            options.verbose |= argument == "--verbose";
+            options.variants.contractFixedCliques |= argument == "--contract";
+            options.variants.annealOnlyFreeVertices |= argument == "--anneal-free";
+            options.variants.pipelinedIterations |= argument == "--pipelined";
+            options.variants.parallelPoolSweep |= argument == "--parallel-sweep";
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Error: Missing value for " << argument << std::endl;
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (argument == "--instances") {
+            options.instanceDirectory = value;
+        } else if (argument == "--algorithms") {
+            options.algorithms = parseList<std::string>(value, [](const std::string& item) { return item; });
+            for (const std::string& algorithm : options.algorithms) {
+                if (algorithm != "fss" && algorithm != "dps") {
+                    std::cerr << "Error: Unknown algorithm " << algorithm << std::endl;
+                    return false;
+                }
+            }
+        } else if (argument == "--seeds") {
+            options.seeds = parseList<uint64_t>(value, [](const std::string& item) { return std::stoull(item); });
+        } else if (argument == "--threads") {
+            options.threadCounts = parseList<int>(value, [](const std::string& item) { return std::stoi(item); });
+        } else if (argument == "--target") {
+            options.target = std::stoi(value);
+        } else if (argument == "--targets") {
+            options.targetsFileName = value;
+        } else if (argument == "--time-limit") {
+            options.timeLimitInSeconds = std::stod(value);
+        } else if (argument == "--iterations") {
+            options.numberOfTotalIterations = std::stoi(value);
+        } else if (argument == "--csv") {
+            options.csvFileName = value;
+        } else if (argument == "--trace-csv") {
+            options.traceCsvFileName = value;
+        } else if (argument == "--json") {
+            options.jsonFileName = value;
+        } else if (argument == "--relaxation-factor") {
+            options.variants.relaxationTemperatureFactor = std::stod(value);
+        } else if (argument == "--portion-strategy" && value == "round-robin") {
+            options.variants.portionSchedulingStrategy = PortionScheduler::ROUND_ROBIN;
+        } else if (argument == "--portion-strategy" && value == "ucb") {
+            options.variants.portionSchedulingStrategy = PortionScheduler::UPPER_CONFIDENCE_BOUND;
+        } else if (argument == "--speculative-reheats") {
+            options.variants.numberOfSpeculativeReheats = std::max(1, std::stoi(value));
+        } else {
+            std::cerr << "Error: Unknown option " << argument << " " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (options.instanceDirectory.empty()) {
+        std::cerr << "Error: No instance directory given." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::map<std::string, int> readTargets(const std::string& filename) {
+    std::map<std::string, int> targets;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open the targets file." << std::endl;
+        return targets;
+    }
+
+    std::string instance;
+    int target;
+    while (file >> instance >> target) {
+        targets[instance] = target;
+    }
+    return targets;
+}
+
+// Sorted by name, so that the runs are always in the same order
+std::vector<std::filesystem::path> listInstances(const std::string& directory) {
+    std::vector<std::filesystem::path> instances;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file()) {
+            instances.push_back(entry.path());
+        }
+    }
+    std::sort(instances.begin(), instances.end());
+    return instances;
+}
+
+RunResult runSearch(const std::string& instance,
+                    const std::vector<int>& vertices,
+                    const std::vector<std::vector<int>>& weights,
+                    double initialTemperature,
+                    const std::string& algorithm,
+                    uint64_t seed,
+                    int numberOfThreads,
+                    std::optional<int> target,
+                    const Options& options) {
+    RunResult result;
+    result.instance = instance;
+    result.algorithm = algorithm;
+    result.seed = seed;
+    result.numberOfThreads = numberOfThreads;
+    result.target = target;
+    result.variants = options.variants;
+
+    CancellationToken deadline = CancellationToken::withTimeLimit(options.timeLimitInSeconds);
+    int timeLimit = static_cast<int>(std::ceil(options.timeLimitInSeconds));
+
+    // The reports of a search never overlap, so they don't need a lock
+    SearchProgressCallback recordProgress = [&](const SearchProgress& progress) {
+        if (result.bestValueOverTime.empty() || progress.bestValue > result.bestValueOverTime.back().bestValue) {
+            result.bestValueOverTime.push_back(progress);
+        }
+        if (progress.finished) {
+            result.seconds = progress.elapsedSeconds;
+            result.completedIterations = progress.completedIterations;
+            // The first report is made after GRASP, so the rate only covers the main loop
+            double secondsOfMainLoop = progress.elapsedSeconds - result.bestValueOverTime.front().elapsedSeconds;
+            result.iterationsPerSecond = secondsOfMainLoop > 0 ? progress.completedIterations / secondsOfMainLoop : 0;
+        }
+        if (target && progress.bestValue >= *target && !result.timeToTarget) {
+            result.timeToTarget = progress.elapsedSeconds;
+            deadline.cancel();
+        }
+    };
+
+    RandomNumberGenerator::seed(seed);
+
+    Partition partition;
+    if (algorithm == "fss") {
+        FixedSetSearch::progressCallback = recordProgress;
+        partition = FixedSetSearch::run(vertices, weights, options.numberOfTotalIterations, timeLimit, initialTemperature, options.batchSizeScaleFactor,
+                                        10, 50, 10, 20, 10, 2, 0.96, 0.01, numberOfThreads, deadline);
+        FixedSetSearch::progressCallback = nullptr;
+        result.portionStatistics = FixedSetSearch::lastPortionStatistics;
+    } else {
+        DiversePoolSearch::progressCallback = recordProgress;
+        partition = DiversePoolSearch::run(vertices, weights, options.numberOfTotalIterations, timeLimit, initialTemperature, options.batchSizeScaleFactor,
+                                           "", 10, 3, 0.96, 0.01, 2, -1, numberOfThreads, deadline);
+        DiversePoolSearch::progressCallback = nullptr;
+    }
+
+    result.bestValue = utils::valueForPartition(partition, weights);
+    return result;
+}
+
+void writeCsv(std::ostream& out, const std::vector<RunResult>& results) {
+    out << "instance,algorithm,seed,threads,target,reached,time_to_target,best_value,seconds,iterations,iterations_per_second,"
+        << "contract,anneal_free,relaxation_factor,pipelined,portion_strategy,parallel_sweep,speculative_reheats\n";
+    out << std::fixed << std::setprecision(3);
+    for (const RunResult& result : results) {
+        out << result.instance << ',' << result.algorithm << ',' << result.seed << ',' << result.numberOfThreads << ',';
+        if (result.target) {
+            out << *result.target;
+        }
+        out << ',' << (result.timeToTarget ? 1 : 0) << ',';
+        if (result.timeToTarget) {
+            out << *result.timeToTarget;
+        }
+        out << ',' << result.bestValue << ',' << result.seconds << ',' << result.completedIterations << ',' << result.iterationsPerSecond << ',';
+
+        const SearchVariants& variants = result.variants;
+        out << variants.contractFixedCliques << ',' << variants.annealOnlyFreeVertices << ',' << variants.relaxationTemperatureFactor << ','
+            << variants.pipelinedIterations << ',' << variants.portionSchedulingStrategyName() << ',' << variants.parallelPoolSweep << ','
+            << variants.numberOfSpeculativeReheats << '\n';
+    }
+}
+
+void writeTraceCsv(std::ostream& out, const std::vector<RunResult>& results) {
+    out << "instance,algorithm,seed,threads,seconds,best_value,iterations\n";
+    out << std::fixed << std::setprecision(3);
+    for (const RunResult& result : results) {
+        for (const SearchProgress& progress : result.bestValueOverTime) {
+            out << result.instance << ',' << result.algorithm << ',' << result.seed << ',' << result.numberOfThreads << ','
+                << progress.elapsedSeconds << ',' << progress.bestValue << ',' << progress.completedIterations << '\n';
+        }
+    }
+}
+
+void writeJson(std::ostream& out, const std::vector<RunResult>& results) {
+    // Instance names are file names, which are written as they are
+    out << std::fixed << std::setprecision(3);
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const RunResult& result = results[i];
+        out << "  {\"instance\": \"" << result.instance << "\", \"algorithm\": \"" << result.algorithm << "\", \"seed\": " << result.seed
+            << ", \"threads\": " << result.numberOfThreads << ", \"target\": ";
+        if (result.target) {
+            out << *result.target;
+        } else {
+            out << "null";
+        }
+        out << ", \"time_to_target\": ";
+        if (result.timeToTarget) {
+            out << *result.timeToTarget;
+        } else {
+            out << "null";
+        }
+        out << ", \"best_value\": " << result.bestValue << ", \"seconds\": " << result.seconds << ", \"iterations\": " << result.completedIterations
+            << ", \"iterations_per_second\": " << result.iterationsPerSecond;
+
+        const SearchVariants& variants = result.variants;
+        out << std::boolalpha << ", \"variants\": {\"contract\": " << variants.contractFixedCliques << ", \"anneal_free\": " << variants.annealOnlyFreeVertices
+            << ", \"relaxation_factor\": " << variants.relaxationTemperatureFactor << ", \"pipelined\": " << variants.pipelinedIterations
+            << ", \"portion_strategy\": \"" << variants.portionSchedulingStrategyName() << "\", \"parallel_sweep\": " << variants.parallelPoolSweep
+            << ", \"speculative_reheats\": " << variants.numberOfSpeculativeReheats << "}" << std::noboolalpha;
+
+        out << ", \"best_value_over_time\": [";
+        for (size_t j = 0; j < result.bestValueOverTime.size(); ++j) {
+            const SearchProgress& progress = result.bestValueOverTime[j];
+            out << (j > 0 ? ", " : "") << "{\"seconds\": " << progress.elapsedSeconds << ", \"best_value\": " << progress.bestValue
+                << ", \"iterations\": " << progress.completedIterations << "}";
+        }
+        out << "], \"portions\": [";
+        for (size_t j = 0; j < result.portionStatistics.size(); ++j) {
+            const auto& [portion, statistics] = result.portionStatistics[j];
+            out << (j > 0 ? ", " : "") << "{\"portion\": " << portion << ", \"iterations\": " << statistics.numberOfIterations
+                << ", \"new_best\": " << statistics.numberOfNewBestSolutions << ", \"improvement\": " << statistics.totalImprovement
+                << ", \"seconds\": " << statistics.seconds << "}";
+        }
+        out << "]}" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
+
+bool writeToFile(const std::string& filename, void (*write)(std::ostream&, const std::vector<RunResult>&), const std::vector<RunResult>& results) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open " << filename << std::endl;
+        return false;
+    }
+    write(file, results);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    options.variants.apply();
+
+    std::map<std::string, int> targets;
+    if (!options.targetsFileName.empty()) {
+        targets = readTargets(options.targetsFileName);
+    }
+
+    NullBuffer nullBuffer;
+    std::streambuf* standardOutputBuffer = std::cout.rdbuf();
+
+    std::vector<RunResult> results;
+    for (const std::filesystem::path& instancePath : listInstances(options.instanceDirectory)) {
+        std::string instance = instancePath.filename().string();
+        auto [vertices, weights] = FileReading::readProblemFromFile(instancePath.string());
+        if (vertices.empty()) {
+            std::cerr << "Error: Skipping " << instance << ", which is no instance." << std::endl;
+            continue;
+        }
+
+        std::optional<int> target = options.target;
+        if (targets.count(instance) > 0) {
+            target = targets[instance];
+        }
+
+        // The temperature belongs to the instance, so every run of it starts with the same one
+        RandomNumberGenerator::seed(0);
+        double initialTemperature = SimulatedAnnealing::CalculateSimulatedAnnealingTemperature(vertices, weights, options.batchSizeScaleFactor);
+
+        for (const std::string& algorithm : options.algorithms) {
+            for (int numberOfThreads : options.threadCounts) {
+                for (uint64_t seed : options.seeds) {
+                    if (!options.verbose) {
+                        std::cout.rdbuf(&nullBuffer);
+                    }
+                    results.push_back(runSearch(instance, vertices, weights, initialTemperature, algorithm, seed, numberOfThreads, target, options));
+                    std::cout.rdbuf(standardOutputBuffer);
+
+                    const RunResult& result = results.back();
+                    std::cerr << instance << " " << algorithm << " seed " << seed << " threads " << numberOfThreads << ": best " << result.bestValue;
+                    if (result.timeToTarget) {
+                        std::cerr << ", target reached after " << *result.timeToTarget << " seconds";
+                    }
+                    std::cerr << ", " << result.iterationsPerSecond << " iterations per second" << std::endl;
+                }
+            }
+        }
+    }
+
+    bool success = true;
+    if (options.csvFileName.empty()) {
+        writeCsv(std::cout, results);
+    } else {
+        success &= writeToFile(options.csvFileName, writeCsv, results);
+    }
+    if (!options.traceCsvFileName.empty()) {
+        success &= writeToFile(options.traceCsvFileName, writeTraceCsv, results);
+    }
+    if (!options.jsonFileName.empty()) {
+        success &= writeToFile(options.jsonFileName, writeJson, results);
+    }
+
+    return success ? 0 : 2;
+}
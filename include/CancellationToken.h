@@ -0,0 +1,66 @@
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+/**
+ * Tells long running stages to stop early and return the best solution found so far.
+ * A token is cancelled when cancel() was called on it or on a token it was derived from, or when its deadline has passed.
+ * Copies share the same state, so a token can be handed to other threads by value.
+ */
+class CancellationToken {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    // Token without a deadline, which is only cancelled by cancel()
+    CancellationToken() : CancellationToken(Clock::time_point::max(), nullptr) {}
+
+    static CancellationToken withDeadline(Clock::time_point deadline) {
+        return CancellationToken(deadline, nullptr);
+    }
+
+    static CancellationToken withTimeLimit(double seconds) {
+        return withDeadline(Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds)));
+    }
+
+    // Token that is also cancelled with this token, but can be cancelled on its own or get an earlier deadline
+    CancellationToken childToken(Clock::time_point deadline = Clock::time_point::max()) const {
+        return CancellationToken(std::min(deadline, state->deadline), state);
+    }
+
+    void cancel() const {
+        state->cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    bool isCancelled() const {
+        for (const State* s = state.get(); s != nullptr; s = s->parent.get()) {
+            if (s->cancelled.load(std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return state->deadline != Clock::time_point::max() && Clock::now() >= state->deadline;
+    }
+
+    Clock::time_point deadline() const {
+        return state->deadline;
+    }
+
+   private:
+    struct State {
+        std::atomic<bool> cancelled{false};
+        Clock::time_point deadline;
+        std::shared_ptr<const State> parent;
+    };
+
+    std::shared_ptr<State> state;
+
+    CancellationToken(Clock::time_point deadline, std::shared_ptr<const State> parent) : state(std::make_shared<State>()) {
+        state->deadline = deadline;
+        state->parent = std::move(parent);
+    }
+};
+
+#endif  // CANCELLATION_TOKEN_H
@@ -0,0 +1,90 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "RandomNumberGenerator.h"
+
+/**
+ * State of a FixedSetSearch or DiversePoolSearch run, from which the run can be continued without GRASP.
+ * The file starts with a magic number and a version, followed by the state in binary (native byte order),
+ * and the labels of the pool solutions take 4 bytes per vertex and solution.
+ */
+class Checkpoint {
+   public:
+    enum Algorithm : uint32_t {
+        FIXED_SET_SEARCH = 1,
+        DIVERSE_POOL_SEARCH = 2
+    };
+
+    struct WorkerState {
+        int portionIndex = 0;
+        int stagnationCounter = 0;
+        RandomNumberGenerator::State randomNumberGeneratorState = {};
+    };
+
+    Algorithm algorithm = FIXED_SET_SEARCH;
+    double elapsedSeconds = 0.0;
+
+    // FSS: the next iteration, DPS: the next iteration of the outer loop
+    int nextIteration = 0;
+
+    // DPS: the index of the next solution to improve in the current iteration
+    int nextSolutionIndex = 0;
+
+    // clique index for every vertex and value of each solution in the pool
+    std::vector<std::pair<std::vector<int>, int>> solutions;
+
+    std::vector<WorkerState> workerStates;
+
+    // Writes to a temporary file first, which then replaces the checkpoint, so that a crash never leaves a broken checkpoint behind
+    static bool write(
+        const std::string& fileName,
+        const Checkpoint& checkpoint);
+
+    static std::optional<Checkpoint> read(
+        const std::string& fileName);
+
+    // Whether every pool solution has a clique index in [-1, numberOfVertices) for each of the vertices.
+    // The stored values aren't trusted, the search recomputes them from the weights.
+    bool fitsProblem(
+        int numberOfVertices) const;
+};
+
+/**
+ * Writes checkpoints on a thread of its own, so that the search doesn't wait for the disk.
+ * If a checkpoint is submitted while the previous one is still waiting to be written, only the newer one is written.
+ */
+class CheckpointWriter {
+   public:
+    explicit CheckpointWriter(
+        std::string fileName);
+
+    // Writes the last submitted checkpoint before returning
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void submit(
+        Checkpoint checkpoint);
+
+   private:
+    std::string fileName;
+    std::optional<Checkpoint> pendingCheckpoint;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable checkpointAvailable;
+    std::thread writingThread;
+
+    void writeLoop();
+};
+
+#endif  // CHECKPOINT_H
@@ -0,0 +1,43 @@
+#ifndef CO_MEMBERSHIP_SKETCH_H
+#define CO_MEMBERSHIP_SKETCH_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Partition.h"
+
+/**
+ * Which of a fixed sample of vertex pairs are in the same clique of a partition.
+ * The share of differing bits of two sketches estimates the Rand error of the partitions,
+ * and the bits are split into bands for locality sensitive hashing: partitions with a small Rand error
+ * very likely agree on all bits of at least one band, while partitions far apart rarely do.
+ */
+class CoMembershipSketch {
+   public:
+    static const int numberOfBands = 8;
+    static const int bitsPerBand = 16;
+    static const int numberOfSampledPairs = numberOfBands * bitsPerBand;
+
+    CoMembershipSketch() = default;
+
+    CoMembershipSketch(
+        const Partition& partition,
+        const std::vector<std::pair<int, int>>& sampledPairs);
+
+    // Always the same pairs for the same number of vertices, as only sketches of the same pairs can be compared
+    static std::vector<std::pair<int, int>> samplePairs(
+        int numberOfVertices);
+
+    bool sharesBand(
+        const CoMembershipSketch& other) const;
+
+    int hammingDistance(
+        const CoMembershipSketch& other) const;
+
+   private:
+    std::array<uint64_t, numberOfSampledPairs / 64> bits = {};
+};
+
+#endif  // CO_MEMBERSHIP_SKETCH_H
@@ -1,15 +1,27 @@
 #ifndef DIVERSE_POOL_SEARCH_H
 #define DIVERSE_POOL_SEARCH_H
 
-#include <list>
+#include <chrono>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "CancellationToken.h"
+#include "Checkpoint.h"
+#include "Partition.h"
+#include "SearchProgress.h"
 #include "SolutionClass.h"
+#include "ThreadPool.h"
 
 class DiversePoolSearch {
    public:
-    static std::vector<std::list<int>> run(
+    static std::string checkpointFileName;
+    static double checkpointIntervalSeconds;
+    static bool parallelPoolSweep;
+    static int numberOfSpeculativeReheats;
+    static SearchProgressCallback progressCallback;
+
+    static Partition run(
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
         int numberOfTotalIterations,
@@ -22,26 +34,79 @@ class DiversePoolSearch {
         double cooldownFactor = 0.96,  // Theta
         double minimalTransitionRatio = 0.01,
         int lengthOfRandomCandidateList = 2,  // alpha
-        int numberOfGraspIterations = -1);
+        int numberOfGraspIterations = -1,
+        int numberOfThreads = ThreadPool::defaultNumberOfThreads(),
+        const CancellationToken& cancellationToken = CancellationToken());
+
+    // Continues a search from a checkpoint written by a run with checkpointFileName set, without running GRASP again.
+    // The time limit includes the time before the checkpoint. Returns an empty partition if the checkpoint can't be read.
+    static Partition resume(
+        const std::string& checkpointFileName,
+        const std::vector<int>& vertices,
+        const std::vector<std::vector<int>>& weights,
+        int numberOfTotalIterations,
+        int timeLimit,
+        double initialTemperature,
+        double batchSizeScaleFactor,  // sigma
+        const std::string& resultLogFileName = "",
+        int desiredSize = 10,
+        int improvementFactor = 3,
+        double cooldownFactor = 0.96,  // Theta
+        double minimalTransitionRatio = 0.01,
+        int numberOfThreads = ThreadPool::defaultNumberOfThreads(),
+        const CancellationToken& cancellationToken = CancellationToken());
 
    private:
+    // Main loop of the search, starting with the given solutions and optionally the state of a checkpoint
+    static Partition search(
+        const std::vector<int>& vertices,
+        const std::vector<std::vector<int>>& weights,
+        std::vector<SharedSolution> initialSolutions,
+        std::optional<Checkpoint> checkpoint,
+        std::chrono::high_resolution_clock::time_point startTime,
+        int numberOfTotalIterations,
+        double initialTemperature,
+        double batchSizeScaleFactor,
+        const std::string& resultLogFileName,
+        int desiredSize,
+        int improvementFactor,
+        double cooldownFactor,
+        double minimalTransitionRatio,
+        int numberOfThreads,
+        const CancellationToken& timeLimitToken);
+
     static void logResults(
         const std::string& resultLogFileName,
-        const std::vector<SolutionWithValueAndIndexLookup>& solutions);
+        const std::vector<SharedSolution>& solutions);
+
+    static SharedSolution tryImproveSolution(
+        SharedSolution solution,
+        const std::vector<int>& vertices,
+        const std::vector<std::vector<int>>& weights,
+        double initialTemperature,
+        double batchSizeScaleFactor,
+        double cooldownFactor,
+        double minimalTransitionRatio,
+        int improvementFactor,
+        int numberOfThreads,
+        const CancellationToken& cancellationToken);
 
-    static SolutionWithValueAndIndexLookup tryImproveSolution(
-        const SolutionWithValueAndIndexLookup& solution,
+    static bool tryImproveSpeculatively(
+        SharedSolution& solution,
+        const std::vector<float>& multipliers,
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
         double initialTemperature,
         double batchSizeScaleFactor,
         double cooldownFactor,
         double minimalTransitionRatio,
-        int improvementFactor);
+        int numberOfThreads,
+        const CancellationToken& cancellationToken);
 
-    static std::vector<SolutionWithValueAndIndexLookup> filterSimilarSolutions(
-        const std::vector<SolutionWithValueAndIndexLookup>& solutions,
-        float similarityThreshold);
+    static std::vector<SharedSolution> filterSimilarSolutions(
+        const std::vector<SharedSolution>& solutions,
+        float similarityThreshold,
+        int numberOfThreads);
 };
 
 #endif  // DIVERSE_POOL_SEARCH_H
\ No newline at end of file
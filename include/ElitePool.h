@@ -0,0 +1,64 @@
+#ifndef ELITE_POOL_H
+#define ELITE_POOL_H
+
+#include <vector>
+
+#include "SolutionClass.h"
+#include "SolutionHashSet.h"
+
+/**
+ * Pool of the best solutions found so far, sorted by their values (best first) and without duplicates.
+ * The position of a new solution is found by binary search, and as the pool only holds pointers,
+ * shifting the worse solutions back is cheap for the pool sizes used.
+ */
+class ElitePool {
+   public:
+    explicit ElitePool(
+        int capacity);
+
+    int size() const;
+    int capacity() const;
+    bool empty() const;
+    bool full() const;
+
+    const SharedSolution& operator[](
+        int index) const;
+
+    const SharedSolution& best() const;
+    const SharedSolution& worst() const;
+
+    std::vector<SharedSolution>::const_iterator begin() const;
+    std::vector<SharedSolution>::const_iterator end() const;
+
+    const std::vector<SharedSolution>& solutions() const;
+
+    // Whether an equal solution is in the pool
+    bool contains(
+        const SolutionWithValueAndIndexLookup& solution) const;
+
+    // Whether exactly the given solution is in the pool
+    bool holds(
+        const SharedSolution& solution) const;
+
+    // Index the solution would get, behind all solutions with at least the same value
+    int insertPosition(
+        int value) const;
+
+    // Whether tryInsert would add the solution, which is the case if it is new and the pool isn't full or the solution is better than the worst
+    bool accepts(
+        const SolutionWithValueAndIndexLookup& solution) const;
+
+    // Adds the solution if it is accepted, replacing the worst solution if the pool is full
+    bool tryInsert(
+        SharedSolution solution);
+
+    void erase(
+        int index);
+
+   private:
+    std::vector<SharedSolution> sortedSolutions;
+    SolutionHashSet uniqueSolutions;
+    int maximalNumberOfSolutions;
+};
+
+#endif  // ELITE_POOL_H
@@ -1,14 +1,36 @@
 #ifndef FIXED_SET_SEARCH_H
 #define FIXED_SET_SEARCH_H
 
-#include <list>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "CancellationToken.h"
+#include "Checkpoint.h"
+#include "ElitePool.h"
+#include "GraphContraction.h"
+#include "Partition.h"
+#include "PortionScheduler.h"
+#include "SearchProgress.h"
 #include "SolutionClass.h"
+#include "ThreadPool.h"
 
 class FixedSetSearch {
    public:
-    static std::vector<std::list<int>> run(
+    static bool contractFixedCliques;
+    static bool annealOnlyFreeVertices;
+    static double relaxationTemperatureFactor;
+    static bool pipelinedIterations;
+    static int numberOfPreparedIterations;
+    static PortionScheduler::Strategy portionSchedulingStrategy;
+    static std::string checkpointFileName;
+    static double checkpointIntervalSeconds;
+    static SearchProgressCallback progressCallback;
+    static std::vector<std::pair<double, PortionScheduler::PortionStatistics>> lastPortionStatistics;
+
+    static Partition run(
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
         int numberOfTotalIterations,
@@ -22,16 +44,98 @@ class FixedSetSearch {
         int numberOfGRASPIterations = 10,
         int lengthOfRandomCandidateList = 2,  // alpha
         double cooldownFactor = 0.96,         // Theta
-        double minimalTransitionRatio = 0.01);
+        double minimalTransitionRatio = 0.01,
+        int numberOfThreads = ThreadPool::defaultNumberOfThreads(),
+        const CancellationToken& cancellationToken = CancellationToken());
 
-    static std::vector<std::list<int>> findFixedPartialSolution(
-        const std::vector<std::list<int>>& baseSolution,
-        const std::vector<SolutionWithValueAndIndexLookup>& solutionsForFixedSet,
+    // Continues a search from a checkpoint written by a run with checkpointFileName set, without running GRASP again.
+    // The time limit includes the time before the checkpoint. Returns an empty partition if the checkpoint can't be read.
+    static Partition resume(
+        const std::string& checkpointFileName,
+        const std::vector<int>& vertices,
+        const std::vector<std::vector<int>>& weights,
+        int numberOfTotalIterations,
+        int timeLimit,
+        double initialTemperature,
+        double batchSizeScaleFactor,  // sigma
+        int m = 10,
+        int n = 50,
+        int k = 10,
+        int maximumStagnationCountPerPortion = 20,
+        int lengthOfRandomCandidateList = 2,  // alpha
+        double cooldownFactor = 0.96,         // Theta
+        double minimalTransitionRatio = 0.01,
+        int numberOfThreads = ThreadPool::defaultNumberOfThreads(),
+        const CancellationToken& cancellationToken = CancellationToken());
+
+    static Partition findFixedPartialSolution(
+        const Partition& baseSolution,
+        const std::vector<SharedSolution>& solutionsForFixedSet,
         double portionOfFixedVertices);
 
    private:
+    // Main loop of the search, starting with the given solutions and optionally the state of a checkpoint
+    static Partition search(
+        const std::vector<int>& vertices,
+        const std::vector<std::vector<int>>& weights,
+        std::vector<SharedSolution> initialSolutions,
+        std::optional<Checkpoint> checkpoint,
+        std::chrono::high_resolution_clock::time_point startTime,
+        int firstIteration,
+        int numberOfTotalIterations,
+        double initialTemperature,
+        double batchSizeScaleFactor,
+        int m,
+        int n,
+        int k,
+        int maximumStagnationCountPerPortion,
+        int lengthOfRandomCandidateList,
+        double cooldownFactor,
+        double minimalTransitionRatio,
+        int numberOfThreads,
+        const CancellationToken& timeLimitToken);
+
+    // Start of an iteration, everything before simulated annealing
+    struct PreparedIteration {
+        SharedSolution baseSolution;
+        int portionIndex;
+
+        // In the contracted problem if the fixed cliques are contracted
+        Partition fixedPartialSolution;
+        Partition partition;
+        std::optional<GraphContraction::ContractedProblem> contractedProblem;
+    };
+
+    // Picks the fixed partial solution and completes it with GreedyAdding and GreedyMoving
+    static PreparedIteration prepareIteration(
+        const ElitePool& solutionsWithValues,
+        const std::vector<int>& vertices,
+        const std::vector<std::vector<int>>& weights,
+        int m,
+        int n,
+        int k,
+        int portionIndex,
+        double portionOfFixedVertices,
+        int lengthOfRandomCandidateList,
+        const CancellationToken& cancellationToken);
+
+    // Runs simulated annealing on the prepared partition, returns the partition along with its value
+    static std::pair<Partition, int> finishIteration(
+        const PreparedIteration& preparedIteration,
+        const std::vector<int>& vertices,
+        const std::vector<std::vector<int>>& weights,
+        double initialTemperature,
+        double batchSizeScaleFactor,
+        double cooldownFactor,
+        double minimalTransitionRatio,
+        const CancellationToken& cancellationToken);
+
+    static bool isOutdated(
+        const PreparedIteration& preparedIteration,
+        const ElitePool& solutionsWithValues);
+
     static void shuffleVector(
-        std::vector<SolutionWithValueAndIndexLookup>& vec);
+        std::vector<int>& vec);
 
     static std::vector<double> initializeFixedSetSizePortions(
         int numberOfVertices);
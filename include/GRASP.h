@@ -1,16 +1,17 @@
 #ifndef GRASP_H
 #define GRASP_H
 
-#include <list>
 #include <vector>
 
+#include "CancellationToken.h"
 #include "SolutionClass.h"
+#include "ThreadPool.h"
 
 class GRASP {
    public:
     static std::pair<
-        SolutionWithValueAndIndexLookup,
-        std::vector<SolutionWithValueAndIndexLookup>>
+        SharedSolution,
+        std::vector<SharedSolution>>
     run(
         int numberOfDesiredSolutions,
         const std::vector<int>& vertices,
@@ -19,7 +20,9 @@ class GRASP {
         double initialTemperature,
         double batchSizeScaleFactor,
         double cooldownFactor,
-        double minimalTransitionRatio);
+        double minimalTransitionRatio,
+        int numberOfThreads = ThreadPool::defaultNumberOfThreads(),
+        const CancellationToken& cancellationToken = CancellationToken());
 };
 
 #endif  // GRASP_H
@@ -0,0 +1,38 @@
+#ifndef GRAPH_CONTRACTION_H
+#define GRAPH_CONTRACTION_H
+
+#include <vector>
+
+#include "Partition.h"
+
+/**
+ * Contracts every clique of a fixed partial solution into a single vertex,
+ * whose weight to another vertex is the sum of the weights of the clique to it.
+ * The free vertices are kept as they are, so the contracted problem only has
+ * one vertex per fixed clique plus the free vertices.
+ */
+class GraphContraction {
+   public:
+    struct ContractedProblem {
+        std::vector<int> vertices;
+        std::vector<std::vector<int>> weights;
+
+        // Every contracted clique is in its own clique, the free vertices are not assigned
+        Partition initialPartition;
+
+        // Sum of the weights inside the contracted cliques, which is part of the value of every expanded partition
+        int valueOfContractedCliques = 0;
+
+        std::vector<int> contractedVertexForVertex;
+    };
+
+    static ContractedProblem contract(
+        const Partition& fixedPartialSolution,
+        const std::vector<std::vector<int>>& weights);
+
+    static Partition expand(
+        const Partition& contractedPartition,
+        const ContractedProblem& contractedProblem);
+};
+
+#endif  // GRAPH_CONTRACTION_H
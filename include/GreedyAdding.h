@@ -1,48 +1,56 @@
 #ifndef GREEDY_ADDING_H
 #define GREEDY_ADDING_H
 
-#include <list>
 #include <vector>
 
+#include "CancellationToken.h"
+#include "Partition.h"
+#include "RestrictedCandidateList.h"
+
 class GreedyAdding {
    public:
-    static std::vector<std::list<int>> runForEmptyPartition(
+    static Partition runForEmptyPartition(
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
-        int lengthOfRandomCandidateList);
+        int lengthOfRandomCandidateList,
+        const CancellationToken& cancellationToken = CancellationToken());
 
-    static std::vector<std::list<int>> run(
+    // If the token is cancelled, the vertices that are not added yet are put into cliques of their own
+    static Partition run(
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
-        std::vector<std::list<int>>& initialPartition,
-        int lengthOfRandomCandidateList);
+        const Partition& initialPartition,
+        int lengthOfRandomCandidateList,
+        const CancellationToken& cancellationToken = CancellationToken());
 
    private:
     static void addingVertexToPartitionStep(
         std::vector<int>& candidateVertices,
         std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
-        std::vector<std::list<int>>& currentPartition,
+        std::vector<int>& cliqueIndexForVertex,
+        std::vector<int>& numberOfVerticesInCliques,
         const std::vector<std::vector<int>>& weights,
-        int lengthOfRandomCandidateList);
+        RestrictedCandidateList& restrictedCandidateList,
+        int& firstEmptyCliqueIndex);
 
     static std::pair<int, int> getIndicesOfRandomAddingMoveFromBestOptions(
         const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
-        int lengthOfRandomCandidateList,
-        const std::vector<int>& candidateVertices,
-        int firstEmptyCliqueIndex);
+        RestrictedCandidateList& restrictedCandidateList,
+        const std::vector<int>& candidateVertices);
 
     static std::vector<std::vector<int>> initializeBenefitOfAddingVertexToClique(
         const std::vector<int>& candidateVertices,
-        const std::vector<std::list<int>>& currentPartition,
+        const Partition& currentPartition,
+        int numberOfCliques,
         const std::vector<std::vector<int>>& weights);
 
     static void updateBenefitOfAddingVertexToClique(
         std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
         const std::vector<int>& candidateVertices,
-        const std::vector<std::list<int>>& currentPartition,
         const std::vector<std::vector<int>>& weights,
         int vertexIndex,
-        int cliqueIndex);
+        int cliqueIndex,
+        RestrictedCandidateList& restrictedCandidateList);
 };
 
 #endif  // GREEDY_ADDING_H
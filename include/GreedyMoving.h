@@ -1,34 +1,39 @@
 #ifndef GREEDY_MOVING_H
 #define GREEDY_MOVING_H
 
-#include <list>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
+#include "CancellationToken.h"
+#include "Partition.h"
+
 class GreedyMoving {
    public:
-    static std::vector<std::list<int>> run(
+    // Stops after the current move if the token is cancelled
+    static Partition run(
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
-        std::vector<std::list<int>> partition);
+        const Partition& partition,
+        const CancellationToken& cancellationToken = CancellationToken());
 
     static void updateMovingTable(
         const std::vector<std::vector<int>>& weights,
-        const std::vector<std::list<int>>& currentPartition,
+        const std::vector<int>& cliqueIndexForVertex,
         std::vector<std::vector<int>>& benefitOfMovingVertex,
         int vertexLastMoved,
         int oldCliqueIndex,
         int newCliqueIndex);
 
     static void moveVertexFromTo(
-        std::vector<std::list<int>>& currentPartition,
+        std::vector<int>& cliqueIndexForVertex,
         int vertex,
-        int oldCliqueIndex,
         int newCliqueIndex);
 
     static std::vector<std::vector<int>> initializeMovingTable(
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
-        const std::vector<std::list<int>>& currentPartition);
+        const Partition& currentPartition);
 
    private:
     static std::pair<size_t, size_t> getBestMove(
@@ -0,0 +1,82 @@
+#ifndef INSTANCE_GENERATOR_H
+#define INSTANCE_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Generates clique partitioning instances of any size, e.g. for scaling studies.
+ * The weight of a pair of vertices is a hash of the seed and the pair, so it can be computed in any order:
+ * the instance in memory and the instance written to a file are the same, and writing only needs memory for a few rows.
+ *
+ * UNIFORM gives a pair a weight in [minimalWeight, maximalWeight] with probability density, like the random instances of CP-Lib.
+ * PLANTED_PARTITION assigns the vertices to random clusters, pairs in the same cluster get positive and all others negative weights,
+ * and the sign of a weight is flipped with probability noise.
+ * GEOMETRIC places the vertices at random points in the unit square, pairs closer than radius get positive weights
+ * that decrease with their distance, and pairs further apart get negative weights.
+ * SPARSE is like UNIFORM, but with a density that gives every vertex averageDegree non-zero weights on average, independent of the size.
+ */
+class InstanceGenerator {
+   public:
+    enum Variant {
+        UNIFORM,
+        PLANTED_PARTITION,
+        GEOMETRIC,
+        SPARSE
+    };
+
+    struct Options {
+        Variant variant = UNIFORM;
+        int numberOfVertices = 100;
+        double density = 1.0;  // portion of the pairs with a non-zero weight, except for SPARSE
+        int minimalWeight = -100;
+        int maximalWeight = 100;
+        uint64_t seed = 1;
+
+        int numberOfClusters = 10;  // PLANTED_PARTITION
+        double noise = 0.1;         // PLANTED_PARTITION
+        double radius = 0.2;        // GEOMETRIC
+        double averageDegree = 10;  // SPARSE
+    };
+
+    explicit InstanceGenerator(Options options);
+
+    int numberOfVertices() const;
+
+    int weight(
+        int vertex1,
+        int vertex2) const;
+
+    // Cluster of the vertex for PLANTED_PARTITION, -1 for the other variants
+    int plantedCliqueIndexForVertex(
+        int vertex) const;
+
+    // Vertices and weights in the same form as FileReading::readProblemFromFile
+    std::pair<std::vector<int>, std::vector<std::vector<int>>> generate() const;
+
+    // Writes the instance in CPn format, which FileReading::readProblemFromFile reads. Returns false if the file can't be written.
+    bool writeToFile(
+        const std::string& filename) const;
+
+    static bool parseVariant(
+        const std::string& name,
+        Variant& variant);
+
+   private:
+    Options options;
+
+    // Probability that a pair gets a non-zero weight
+    double edgeProbability;
+
+    std::vector<int> clusterForVertex;
+    std::vector<std::pair<double, double>> pointForVertex;
+
+    // Uniform in [0, 1), a function of the seed, the stream and the key only
+    double randomValue(
+        uint64_t stream,
+        uint64_t key) const;
+};
+
+#endif  // INSTANCE_GENERATOR_H
@@ -0,0 +1,69 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Partition of the vertices into cliques.
+ * Every vertex is labeled with the index of its clique (-1 if it is not assigned to any clique yet),
+ * and the vertices of all cliques are stored next to each other (compressed sparse row layout),
+ * so that iterating over a clique doesn't need a list node per vertex.
+ */
+class Partition {
+   public:
+    class Clique {
+       public:
+        Clique(const int* first, const int* last) : first(first), last(last) {}
+
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        int size() const { return static_cast<int>(last - first); }
+        bool empty() const { return first == last; }
+
+       private:
+        const int* first;
+        const int* last;
+    };
+
+    Partition() = default;
+
+    // Partition in which no vertex is assigned to a clique yet
+    explicit Partition(int numberOfVertices);
+
+    // The clique index -1 marks a vertex that is not assigned to any clique
+    explicit Partition(std::vector<int> cliqueIndexForVertex);
+
+    int numberOfVertices() const;
+
+    // Number of clique indices in use, which includes empty cliques in front of the last non-empty clique
+    int numberOfCliques() const;
+
+    int numberOfNonEmptyCliques() const;
+
+    int cliqueIndexForVertex(int vertex) const;
+
+    bool isAssigned(int vertex) const;
+
+    const std::vector<int>& cliqueIndexForVertexLookup() const;
+
+    Clique clique(int cliqueIndex) const;
+
+    int cliqueSize(int cliqueIndex) const;
+
+    // Hash that doesn't depend on the naming of the cliques, equal partitions always have the same hash
+    uint64_t canonicalHash() const;
+
+    // Renames the cliques to 0, 1, 2, ... in the order of their smallest vertex, which removes all empty cliques.
+    // This doesn't allocate any memory.
+    void relabelInFirstOccurrenceOrder();
+
+   private:
+    std::vector<int> cliqueIndices;
+    std::vector<int> cliqueOffsets;
+    std::vector<int> verticesOfCliques;
+
+    void buildCliques(int numberOfCliques);
+};
+
+#endif  // PARTITION_H
@@ -1,17 +1,138 @@
 #ifndef PARTITION_DISTANCES_H
 #define PARTITION_DISTANCES_H
 
-#include <list>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "Partition.h"
+#include "ThreadPool.h"
+
 enum Metric {
     RAND_ERROR,
     VI,
 };
 
-std::vector<std::vector<float>> computeUpperDistanceMatrix(
-    const std::vector<std::vector<int>>& solutions,
-    Metric metric = Metric::RAND_ERROR);
+/**
+ * Distances of two partitions given by the clique index of every vertex, the same as andres::RandError(...).error()
+ * and andres::VariationOfInformation(...).value().
+ * Clique indices are small, so the contingency table is counted with flat arrays instead of maps in O(n),
+ * and the arrays are kept for the next call, so that no memory is allocated once they are large enough.
+ */
+class PartitionDistanceCalculator {
+   public:
+    // Number of vertex pairs that are in the same clique in one partition, but not in the other
+    int64_t numberOfDisagreeingPairs(
+        const std::vector<int>& cliqueIndexForVertex1,
+        const std::vector<int>& cliqueIndexForVertex2);
+
+    double randError(
+        const std::vector<int>& cliqueIndexForVertex1,
+        const std::vector<int>& cliqueIndexForVertex2);
+
+    double variationOfInformation(
+        const std::vector<int>& cliqueIndexForVertex1,
+        const std::vector<int>& cliqueIndexForVertex2);
+
+    // Same as randError(...) < threshold, but stops as soon as bounds on the number of disagreeing pairs decide it,
+    // which for clearly dissimilar or similar partitions is after a few cliques of the first partition.
+    // The cliques of the partitions are used directly, so nothing has to be sorted first.
+    bool isRandErrorBelow(
+        const Partition& partition1,
+        const Partition& partition2,
+        double threshold);
+
+    // Least and most number of disagreeing pairs, once it is known on which side of the threshold the Rand error is
+    std::pair<int64_t, int64_t> boundDisagreeingPairs(
+        const Partition& partition1,
+        const Partition& partition2,
+        double threshold);
+
+   private:
+    // The vertices of each clique of the first partition, in the layout of Partition.
+    // Clique indices are shifted by one, so that unassigned vertices (-1) are a clique of their own.
+    std::vector<int> cliqueOffsets1;
+    std::vector<int> verticesOfCliques1;
+
+    std::vector<int> cliqueSizes2;
+
+    // Number of vertices of the current clique of the first partition in each clique of the second partition
+    std::vector<int> overlapCounts;
+
+    // Sorts the vertices by their clique in the first partition and counts the clique sizes of the second partition into cliqueSizes2.
+    // Returns the sums of the squared clique sizes of both partitions.
+    std::pair<uint64_t, uint64_t> prepare(
+        const std::vector<int>& cliqueIndexForVertex1,
+        const std::vector<int>& cliqueIndexForVertex2);
+
+    // Sum of the squared overlaps of a clique of the first partition with all cliques of the second partition
+    uint64_t squaredOverlaps(
+        Partition::Clique clique1,
+        const std::vector<int>& cliqueIndexForVertex2);
+};
+
+// The Rand error is the share of disagreeing pairs among all vertex pairs
+double randErrorForDisagreeingPairs(
+    int64_t numberOfDisagreeingPairs,
+    int64_t numberOfVertices);
+
+// These use a PartitionDistanceCalculator of the calling thread
+int64_t numberOfDisagreeingPairs(
+    const std::vector<int>& cliqueIndexForVertex1,
+    const std::vector<int>& cliqueIndexForVertex2);
+
+double randError(
+    const std::vector<int>& cliqueIndexForVertex1,
+    const std::vector<int>& cliqueIndexForVertex2);
+
+bool isRandErrorBelow(
+    const Partition& partition1,
+    const Partition& partition2,
+    double threshold);
+
+std::pair<int64_t, int64_t> boundDisagreeingPairs(
+    const Partition& partition1,
+    const Partition& partition2,
+    double threshold);
+
+double variationOfInformation(
+    const std::vector<int>& cliqueIndexForVertex1,
+    const std::vector<int>& cliqueIndexForVertex2);
+
+/**
+ * Symmetric matrix of the distances between each two of a number of partitions,
+ * which only stores the pairs above the diagonal, row by row.
+ */
+class CondensedDistanceMatrix {
+   public:
+    explicit CondensedDistanceMatrix(
+        int numberOfPartitions);
+
+    int size() const;
+
+    // Distance of two different partitions, in any order
+    float operator()(
+        int index1,
+        int index2) const;
+
+    float& operator()(
+        int index1,
+        int index2);
+
+   private:
+    int numberOfPartitions;
+    std::vector<float> distances;
+
+    size_t pairIndex(
+        int index1,
+        int index2) const;
+};
+
+// The pairs are split between the threads, each with its own PartitionDistanceCalculator
+CondensedDistanceMatrix computeDistanceMatrix(
+    const std::vector<std::vector<int>>& partitions,
+    Metric metric = Metric::RAND_ERROR,
+    int numberOfThreads = ThreadPool::defaultNumberOfThreads());
 
 #endif  // PARTITION_DISTANCES_H
\ No newline at end of file
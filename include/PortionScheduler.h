@@ -0,0 +1,70 @@
+#ifndef PORTION_SCHEDULER_H
+#define PORTION_SCHEDULER_H
+
+#include <vector>
+
+/**
+ * Decides which portion of fixed vertices the next FSS iteration uses.
+ * ROUND_ROBIN moves on to the next portion after a number of iterations without a new best solution, like the original FSS.
+ * UPPER_CONFIDENCE_BOUND treats the portions as arms of a multi-armed bandit (UCB1), whose reward is
+ * the improvement over the base solution per second, so that more iterations go to the portions that pay off.
+ */
+class PortionScheduler {
+   public:
+    enum Strategy {
+        ROUND_ROBIN,
+        UPPER_CONFIDENCE_BOUND
+    };
+
+    struct PortionStatistics {
+        int numberOfIterations = 0;
+        int numberOfNewBestSolutions = 0;
+        long long totalImprovement = 0;
+        double seconds = 0.0;
+    };
+
+    PortionScheduler(
+        std::vector<double> portions,
+        Strategy strategy,
+        int maximumStagnationCountPerPortion,
+        int firstPortionIndex = 0,
+        double explorationFactor = 1.4);
+
+    int currentPortionIndex() const;
+
+    double currentPortion() const;
+
+    double portion(
+        int portionIndex) const;
+
+    // Records the result of an iteration with the given portion and chooses the portion for the next iteration
+    void recordIteration(
+        int portionIndex,
+        int improvement,
+        bool foundNewBest,
+        double seconds);
+
+    const std::vector<PortionStatistics>& statistics() const;
+
+    int stagnationCount() const;
+
+    // Continues from a saved state, the statistics are not restored
+    void restore(
+        int portionIndex,
+        int stagnationCounter);
+
+   private:
+    std::vector<double> portions;
+    std::vector<PortionStatistics> portionStatistics;
+    Strategy strategy;
+    int maximumStagnationCountPerPortion;
+    double explorationFactor;
+
+    int portionIndex;
+    int stagnationCounter = 0;
+    int numberOfIterations = 0;
+
+    int portionWithHighestUpperConfidenceBound() const;
+};
+
+#endif  // PORTION_SCHEDULER_H
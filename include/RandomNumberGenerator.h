@@ -7,6 +7,8 @@
 
 class RandomNumberGenerator {
    public:
+    using State = std::array<uint32_t, 4>;
+
     static int getRandomNumberBelow(int maximum) {
         return xoshiro128p() % maximum;
     }
@@ -15,9 +17,61 @@ class RandomNumberGenerator {
         return xoshiro128p() / 4294967295.0f;
     }
 
+    // Random value to seed another stream of random numbers with
+    static uint64_t getRandomSeed() {
+        return (static_cast<uint64_t>(xoshiro128p()) << 32) ^ xoshiro128p();
+    }
+
+    // Every thread has its own generator, this sets the state of the generator of the calling thread
+    static void seed(uint64_t seed) {
+        // splitmix64 to spread the seed over the whole state, see https://prng.di.unimi.it/splitmix64.c
+        State& s = state();
+        for (uint32_t& word : s) {
+            seed += 0x9e3779b97f4a7c15;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            word = static_cast<uint32_t>(z ^ (z >> 31));
+        }
+        if (s[0] == 0 && s[1] == 0 && s[2] == 0 && s[3] == 0) {
+            s[0] = 1;  // the state must not be all zero
+        }
+    }
+
+    static State getState() {
+        return state();
+    }
+
+    static void setState(const State& newState) {
+        state() = newState;
+    }
+
+    // Lets the calling thread use its own stream of random numbers, until the object goes out of scope
+    class ScopedSeed {
+       public:
+        explicit ScopedSeed(uint64_t seed) : previousState(getState()) {
+            RandomNumberGenerator::seed(seed);
+        }
+
+        ~ScopedSeed() {
+            setState(previousState);
+        }
+
+        ScopedSeed(const ScopedSeed&) = delete;
+        ScopedSeed& operator=(const ScopedSeed&) = delete;
+
+       private:
+        State previousState;
+    };
+
    private:
+    static State& state() {
+        thread_local State s = {2, 1, 1, 1};  // Example seed, should be non-zero
+        return s;
+    }
+
     static uint32_t xoshiro128p() {
-        static std::array<uint32_t, 4> s = {2, 1, 1, 1};  // Example seed, should be non-zero
+        State& s = state();
         const uint32_t result = s[0] + s[3];
         const uint32_t t = s[1] << 9;
 
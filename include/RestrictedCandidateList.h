@@ -0,0 +1,68 @@
+#ifndef RESTRICTED_CANDIDATE_LIST_H
+#define RESTRICTED_CANDIDATE_LIST_H
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * Keeps track of the best adding moves (vertex, clique) of the benefit table used by GreedyAdding.
+ * For every candidate vertex the best few cliques are stored, so that a change of a single clique column
+ * only needs to look at one entry per candidate vertex, instead of rescanning the whole benefit table
+ * every time a vertex is added to the partition.
+ */
+class RestrictedCandidateList {
+   public:
+    RestrictedCandidateList(
+        const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
+        int lengthOfRandomCandidateList,
+        const std::vector<int>& activeCliques);
+
+    // Has to be called after the column of the given clique was changed in the benefit table
+    void updateClique(
+        const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
+        int cliqueIndex);
+
+    // Starts considering the given (so far ignored) clique for adding moves
+    void activateClique(
+        const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
+        int cliqueIndex);
+
+    // Mirrors removing a row from the benefit table by moving the last row into its place
+    void removeVertex(
+        int vertexIndex);
+
+    // Tuple for
+    // 1. vertexIndex
+    // 2. cliqueIndex
+    // 3. benefit
+    const std::vector<std::tuple<int, int, int>>& getBestMoves();
+
+   private:
+    int lengthOfRandomCandidateList;
+    int numberOfVertices;
+    std::vector<int> activeCliques;
+
+    // The best moves of every vertex as pairs of (benefit, cliqueIndex), sorted by decreasing benefit.
+    // Vertex i owns the entries [i * lengthOfRandomCandidateList, i * lengthOfRandomCandidateList + numberOfBestMovesOfVertex[i]).
+    std::vector<std::pair<int, int>> bestMovesOfVertex;
+    std::vector<int> numberOfBestMovesOfVertex;
+
+    // Reused buffer for the result of getBestMoves
+    std::vector<std::tuple<int, int, int>> bestMoves;
+
+    void rebuildVertex(
+        const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
+        int vertexIndex);
+
+    void offerMove(
+        int vertexIndex,
+        int cliqueIndex,
+        int benefit);
+
+    void restoreOrder(
+        int vertexIndex,
+        int changedPosition);
+};
+
+#endif  // RESTRICTED_CANDIDATE_LIST_H
@@ -0,0 +1,26 @@
+#ifndef SEARCH_PROGRESS_H
+#define SEARCH_PROGRESS_H
+
+#include <functional>
+
+/**
+ * State of a running search, reported when it finds a new best solution and when it is done,
+ * e.g. to record the best value over time or to stop the search once a target value is reached.
+ */
+struct SearchProgress {
+    int bestValue = 0;
+
+    // Since the start of the run, including GRASP and the time before a checkpoint
+    double elapsedSeconds = 0;
+
+    // Iterations of the main loop finished by this call, not counting GRASP or the iterations before a checkpoint
+    int completedIterations = 0;
+
+    // Set for the last report of a search
+    bool finished = false;
+};
+
+// Reports of one search never overlap, but they may come from different threads
+using SearchProgressCallback = std::function<void(const SearchProgress&)>;
+
+#endif  // SEARCH_PROGRESS_H
@@ -2,9 +2,14 @@
 #define SIMULATED_ANNEALING_H
 
 #include <cstdint>
-#include <list>
+#include <optional>
+#include <utility>
+#include <tuple>
 #include <vector>
 
+#include "CancellationToken.h"
+#include "Partition.h"
+
 class SimulatedAnnealing {
    public:
     enum MoveType {
@@ -15,18 +20,39 @@ class SimulatedAnnealing {
 
     static bool allowSingletonMoves;
 
-    static std::vector<std::list<int>> run(
-        const std::vector<std::list<int>>& partition,
+    // Returns the best partition that was found along with its value.
+    // If the value of the given partition is already known, it can be passed to avoid evaluating the partition again.
+    static std::pair<Partition, int> run(
+        const Partition& partition,
+        const std::vector<int>& vertices,
+        const std::vector<std::vector<int>>& weights,
+        double initialTemperature,
+        double batchSizeScaleFactor,
+        double cooldownFactor,
+        double minimalTransitionRatio,
+        std::optional<int> partitionValue = std::nullopt,
+        const CancellationToken& cancellationToken = CancellationToken());
+
+    // Same as run, but only the active vertices are picked to be moved, and the batch size is scaled to their number.
+    // The other vertices only move in an optional relaxation phase over all vertices afterwards,
+    // which starts at relaxationTemperatureFactor times the initial temperature (0 skips it).
+    static std::pair<Partition, int> runOnActiveVertices(
+        const Partition& partition,
+        const std::vector<int>& activeVertices,
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
         double initialTemperature,
         double batchSizeScaleFactor,
         double cooldownFactor,
-        double minimalTransitionRatio);
+        double minimalTransitionRatio,
+        std::optional<int> partitionValue = std::nullopt,
+        double relaxationTemperatureFactor = 0.0,
+        const CancellationToken& cancellationToken = CancellationToken());
 
+    // Picks a random vertex out of verticesToMove and performs the best move for it, if it is accepted
     static std::tuple<bool, double, int> step(
         std::vector<int>& numberOfVerticesInCliques,
-        const std::vector<int>& vertices,
+        const std::vector<int>& verticesToMove,
         const std::vector<std::vector<int>>& weights,
         std::vector<std::vector<int>>& benefitOfMoving,
         std::vector<int>& cliqueIndexForVertex,
@@ -67,17 +93,17 @@ class SimulatedAnnealing {
         double currentTemperature);
 
     static std::vector<int> initializeNumberOfVerticesInCliques(
-        const std::vector<std::list<int>>& currentPartition,
+        const Partition& currentPartition,
         int numberOfVertices);
 
     static std::vector<int> initializeCliqueIndexForVertexLookup(
-        const std::vector<std::list<int>>& currentPartition,
+        const Partition& currentPartition,
         int numberOfVertices);
 
     static std::vector<std::vector<int>> initializeEdgeWeightSumsBetweenVertexAndClique(
         const std::vector<int>& vertices,
         const std::vector<std::vector<int>>& weights,
-        const std::vector<std::list<int>>& currentPartition,
+        const Partition& currentPartition,
         int numberOfNonEmptyCliques);
 
     static void updateEdgeWeightSumsBetweenVertexAndClique(
@@ -93,6 +119,23 @@ class SimulatedAnnealing {
         double batchSizeScaleFactor);
 
    private:
+    // Cools down from the initial temperature until the transition ratio stagnates or the token is cancelled,
+    // returns the final temperature
+    static double anneal(
+        const std::vector<int>& verticesToMove,
+        int batchSize,
+        double initialTemperature,
+        double cooldownFactor,
+        double minimalTransitionRatio,
+        const std::vector<std::vector<int>>& weights,
+        std::vector<int>& numberOfVerticesInCliques,
+        std::vector<std::vector<int>>& edgeWeightSumsBetweenVertexAndClique,
+        std::vector<int>& cliqueIndexForVertex,
+        double& currentPartitionValue,
+        std::vector<int>& bestPartitionAsCliqueIndexVector,
+        double& bestPartitionValue,
+        const CancellationToken& cancellationToken);
+
     static std::tuple<int, int> bestClassicalMoveForVertex(
         int vertexToMove,
         int cliqueToMoveFrom,
@@ -123,10 +166,6 @@ class SimulatedAnnealing {
         int cliqueToMoveFrom,
         const std::vector<int>& numberOfVerticesInCliques,
         const std::vector<std::vector<int>>& benefitOfMoving);
-
-    static std::vector<std::list<int>> cliqueIndexVectorToPartition(
-        const std::vector<int>& cliqueIndexForVertex,
-        int numberOfVertices);
 };
 
 #endif  // SIMULATED_ANNEALING_H
@@ -1,21 +1,37 @@
 #ifndef SOLUTION_CLASS_H
 #define SOLUTION_CLASS_H
 
-#include <list>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "Partition.h"
+
 class SolutionWithValueAndIndexLookup {
    public:
     SolutionWithValueAndIndexLookup(
-        const std::vector<std::list<int>>& partition,
+        Partition partition,
+        const std::vector<std::vector<int>>& weights);
+
+    // For partitions whose value is already known, e.g. from the incremental updates of the simulated annealing.
+    // In debug builds the value is checked against a full evaluation.
+    SolutionWithValueAndIndexLookup(
+        Partition partition,
+        int value,
         const std::vector<std::vector<int>>& weights);
 
     // default constructor
     SolutionWithValueAndIndexLookup() = default;
 
-    std::vector<std::list<int>> partition;
+    Partition partition;
     int value = 0;
-    std::vector<int> cliqueIndexForVertex;
+
+    // Computed once, so that finding duplicates only needs a full comparison if the hashes are equal
+    uint64_t hash = 0;
+
+    int cliqueIndexForVertex(int vertex) const;
+
+    const std::vector<int>& cliqueIndexForVertexLookup() const;
 
     bool operator==(const SolutionWithValueAndIndexLookup& other) const;
 
@@ -26,4 +42,7 @@ class SolutionWithValueAndIndexLookup {
     bool operator>(const SolutionWithValueAndIndexLookup& other) const;
 };
 
-#endif  // SOLUTION_CLASS_H
\ No newline at end of file
+// Solutions are not changed after they were created, so the pools can share them instead of copying them
+using SharedSolution = std::shared_ptr<const SolutionWithValueAndIndexLookup>;
+
+#endif  // SOLUTION_CLASS_H
@@ -0,0 +1,29 @@
+#ifndef SOLUTION_HASH_SET_H
+#define SOLUTION_HASH_SET_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "SolutionClass.h"
+
+// Set of solutions that finds duplicates by their canonical hash, a full comparison is only done if the hashes are equal
+class SolutionHashSet {
+   public:
+    bool contains(
+        const SolutionWithValueAndIndexLookup& solution) const;
+
+    // Returns false and doesn't add the solution, if an equal solution is already contained
+    bool insert(
+        const SharedSolution& solution);
+
+    // Removes exactly the given solution (not another, equal one)
+    void erase(
+        const SharedSolution& solution);
+
+    size_t size() const;
+
+   private:
+    std::unordered_multimap<uint64_t, SharedSolution> solutionsByHash;
+};
+
+#endif  // SOLUTION_HASH_SET_H
@@ -2,24 +2,30 @@
 #define SOLUTION_MANAGER_H
 
 #include <algorithm>
-#include <list>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
+#include "CoMembershipSketch.h"
+#include "ElitePool.h"
 #include "SolutionClass.h"
 #include "partition-comparison.hxx"
 
 class SolutionManager {
    public:
+    static int minimalPoolSizeForSketches;
+    static bool exactSimilarityChecks;
+
     SolutionManager(
         float similarityThreshold = 0.02f,
         int maxCapacity = 10);
 
     void initialize(
-        const std::vector<SolutionWithValueAndIndexLookup>& initialSolutions);
+        std::vector<SharedSolution> initialSolutions);
 
     size_t count() const;
 
-    SolutionWithValueAndIndexLookup getSolution(
+    const SharedSolution& getSolution(
         int index) const;
 
     bool similarSolutionExists(
@@ -29,27 +35,61 @@ class SolutionManager {
         const SolutionWithValueAndIndexLookup& candidateSolution) const;
 
     void tryAddSolution(
-        const SolutionWithValueAndIndexLookup& candidateSolution, double elapsedTime);
+        SharedSolution candidateSolution, double elapsedTime);
 
-    SolutionWithValueAndIndexLookup getBestSolution() const;
+    const SharedSolution& getBestSolution() const;
 
-    SolutionWithValueAndIndexLookup getWorstSolution() const;
+    const SharedSolution& getWorstSolution() const;
 
-    const std::vector<SolutionWithValueAndIndexLookup>& getAllSolutions() const;
+    const std::vector<SharedSolution>& getAllSolutions() const;
 
    private:
-    std::vector<SolutionWithValueAndIndexLookup> solutions;
+    ElitePool solutions;
     std::vector<int> attemptCounts;
     float similarityThreshold;
-    int maxCapacity;
 
-    bool isSimilar(
-        const SolutionWithValueAndIndexLookup& solution1,
-        const SolutionWithValueAndIndexLookup& solution2) const;
+    // Number of disagreeing vertex pairs between each two solutions of the pool, in the order of the pool.
+    // Updated with every change of the pool, so that the distances between the solutions are only computed once.
+    std::vector<std::vector<int64_t>> disagreeingPairsInPool;
+
+    // What is known about the distances of the current candidate to the solutions of the pool,
+    // kept until the pool changes, so that each pair is compared at most once.
+    // Because of this, a SolutionManager must not be used by several threads at the same time.
+    struct CandidateComparisons {
+        const SolutionWithValueAndIndexLookup* candidate = nullptr;
+        uint64_t hash = 0;
+
+        // Least and most number of disagreeing pairs with each solution of the pool, which are equal once they are known exactly
+        std::vector<std::pair<int64_t, int64_t>> disagreeingPairs;
+
+        CoMembershipSketch sketch;
+    };
+    mutable CandidateComparisons candidateComparisons;
+
+    // Sketch of each solution of the pool, in the order of the pool, to find the likely similar solutions in large pools
+    std::vector<std::pair<int, int>> sampledPairs;
+    std::vector<CoMembershipSketch> sketches;
+
+    // Indices of the pool solutions in [first, last) that are compared with the candidate, the likely similar ones first
+    std::vector<int> comparisonOrder(
+        const SolutionWithValueAndIndexLookup& candidateSolution,
+        int first,
+        int last) const;
 
-    int findInsertPosition(
+    CandidateComparisons& comparisonsWith(
         const SolutionWithValueAndIndexLookup& candidateSolution) const;
 
+    bool isSimilarToPoolSolution(
+        const SolutionWithValueAndIndexLookup& candidateSolution,
+        int index) const;
+
+    int64_t exactDisagreeingPairsWithPoolSolution(
+        const SolutionWithValueAndIndexLookup& candidateSolution,
+        int index) const;
+
+    void erasePoolSolution(
+        int index);
+
     void removeSimilarSolutionsWithLowerValue(
         const SolutionWithValueAndIndexLookup& solution,
         int startIndex);
@@ -0,0 +1,63 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool {
+   public:
+    explicit ThreadPool(int numberOfThreads = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Pool that is shared by all parts of the search, it grows when more threads are requested
+    static ThreadPool& shared();
+
+    static int defaultNumberOfThreads();
+
+    int size() const;
+
+    // Makes sure that at least the given number of worker threads exists
+    void reserve(
+        int numberOfThreads);
+
+    template <typename Func>
+    std::future<std::invoke_result_t<Func>> submit(Func&& func) {
+        using Result = std::invoke_result_t<Func>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        std::future<Result> result = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return result;
+    }
+
+    // Calls func(i) for all i in [0, count) using up to numberOfThreads threads.
+    // The calling thread takes part in the work, so this can also be used from inside a task of the pool.
+    void parallelFor(
+        int count,
+        const std::function<void(int)>& func,
+        int numberOfThreads);
+
+   private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    mutable std::mutex mutex;
+    std::condition_variable taskAvailable;
+    bool stopping = false;
+
+    void enqueue(
+        std::function<void()> task);
+
+    void workerLoop();
+};
+
+#endif  // THREAD_POOL_H
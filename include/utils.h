@@ -2,24 +2,25 @@
 #define UTILS_H
 
 #include <algorithm>
-#include <list>
+#include <numeric>
 #include <vector>
 
+#include "Partition.h"
+#include "ThreadPool.h"
+
 namespace utils {
-inline int valueForPartition(const std::vector<std::list<int>>& partition,
+inline int valueForPartition(const Partition& partition,
                              const std::vector<std::vector<int>>& weights) {
     int score = 0;
 
-    for (const auto& clique : partition) {
-        // Convert list to vector for easier indexing
-        std::vector<int> verticesInClique(clique.begin(), clique.end());
+    for (int cliqueIndex = 0; cliqueIndex < partition.numberOfCliques(); ++cliqueIndex) {
+        Partition::Clique clique = partition.clique(cliqueIndex);
 
         // Iterate over all unique pairs of vertices in the clique
-        for (size_t i = 0; i < clique.size(); ++i) {
-            for (size_t j = i + 1; j < clique.size(); ++j) {
-                int v1 = verticesInClique[i];
-                int v2 = verticesInClique[j];
-                score += weights[v1][v2];  // Add the weight of the edge between v1 and v2
+        for (const int* v1 = clique.begin(); v1 != clique.end(); ++v1) {
+            const std::vector<int>& weightsOfV1 = weights[*v1];
+            for (const int* v2 = v1 + 1; v2 != clique.end(); ++v2) {
+                score += weightsOfV1[*v2];  // Add the weight of the edge between v1 and v2
             }
         }
     }
@@ -27,14 +28,39 @@ inline int valueForPartition(const std::vector<std::list<int>>& partition,
     return score;
 }
 
-inline int cliqueIndexForVertex(int vertex,
-                                const std::vector<std::list<int>>& partition) {
-    for (size_t i = 0; i < partition.size(); ++i) {
-        if (std::find(partition[i].begin(), partition[i].end(), vertex) != partition[i].end()) {
-            return static_cast<int>(i);  // Found the vertex in this clique
-        }
-    }
-    return -1;  // Vertex not found in any clique
+// Full evaluation for large partitions: for every vertex, the weights to all following vertices in the same clique are summed.
+// The inner loop runs over contiguous memory without branches, so the compiler can vectorize it,
+// and the rows are distributed over the threads. The work is quadratic in the number of vertices independent of the clique sizes.
+inline int valueForPartitionInParallel(const Partition& partition,
+                                       const std::vector<std::vector<int>>& weights,
+                                       int numberOfThreads = ThreadPool::defaultNumberOfThreads()) {
+    const int* cliqueIndices = partition.cliqueIndexForVertexLookup().data();
+    int numberOfVertices = partition.numberOfVertices();
+
+    // Taking every numberOfChunks-th row mixes long and short rows, so all chunks have about the same work
+    int numberOfChunks = std::max(1, std::min(numberOfVertices, 4 * numberOfThreads));
+    std::vector<int> scoresOfChunks(numberOfChunks, 0);
+
+    ThreadPool::shared().parallelFor(
+        numberOfChunks,
+        [&](int chunk) {
+            int score = 0;
+            for (int v1 = chunk; v1 < numberOfVertices; v1 += numberOfChunks) {
+                int cliqueIndex = cliqueIndices[v1];
+                if (cliqueIndex == -1) {
+                    continue;
+                }
+
+                const int* weightsOfV1 = weights[v1].data();
+                for (int v2 = v1 + 1; v2 < numberOfVertices; ++v2) {
+                    score += cliqueIndices[v2] == cliqueIndex ? weightsOfV1[v2] : 0;
+                }
+            }
+            scoresOfChunks[chunk] = score;
+        },
+        numberOfThreads);
+
+    return std::accumulate(scoresOfChunks.begin(), scoresOfChunks.end(), 0);
 }
 }  // namespace utils
 
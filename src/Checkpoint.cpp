@@ -0,0 +1,205 @@
+#include "Checkpoint.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+const uint32_t checkpointMagicNumber = 0x43535346;  // "FSSC"
+const uint32_t checkpointVersion = 1;
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+int64_t bytesUntilEnd(std::ifstream& file) {
+    std::streampos position = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streampos end = file.tellg();
+    file.seekg(position);
+    return static_cast<int64_t>(end - position);
+}
+}  // namespace
+
+bool Checkpoint::write(const std::string& fileName, const Checkpoint& checkpoint) {
+    std::string temporaryFileName = fileName + ".tmp";
+
+    {
+        std::ofstream file(temporaryFileName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open the checkpoint file " << temporaryFileName << "." << std::endl;
+            return false;
+        }
+
+        writeValue(file, checkpointMagicNumber);
+        writeValue(file, checkpointVersion);
+        writeValue(file, static_cast<uint32_t>(checkpoint.algorithm));
+        writeValue(file, checkpoint.elapsedSeconds);
+        writeValue(file, static_cast<int32_t>(checkpoint.nextIteration));
+        writeValue(file, static_cast<int32_t>(checkpoint.nextSolutionIndex));
+
+        int32_t numberOfVertices = checkpoint.solutions.empty() ? 0 : checkpoint.solutions[0].first.size();
+        writeValue(file, static_cast<int32_t>(checkpoint.solutions.size()));
+        writeValue(file, numberOfVertices);
+        for (const auto& [cliqueIndexForVertex, value] : checkpoint.solutions) {
+            writeValue(file, static_cast<int32_t>(value));
+            file.write(reinterpret_cast<const char*>(cliqueIndexForVertex.data()), numberOfVertices * sizeof(int32_t));
+        }
+
+        writeValue(file, static_cast<int32_t>(checkpoint.workerStates.size()));
+        for (const WorkerState& workerState : checkpoint.workerStates) {
+            writeValue(file, static_cast<int32_t>(workerState.portionIndex));
+            writeValue(file, static_cast<int32_t>(workerState.stagnationCounter));
+            writeValue(file, workerState.randomNumberGeneratorState);
+        }
+
+        if (!file.good()) {
+            std::cerr << "Error: Could not write the checkpoint file " << temporaryFileName << "." << std::endl;
+            return false;
+        }
+    }
+
+    if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0) {
+        std::cerr << "Error: Could not replace the checkpoint file " << fileName << "." << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+std::optional<Checkpoint> Checkpoint::read(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open the checkpoint file " << fileName << "." << std::endl;
+        return std::nullopt;
+    }
+
+    uint32_t magicNumber, version, algorithm;
+    if (!readValue(file, magicNumber) || !readValue(file, version) || magicNumber != checkpointMagicNumber || version != checkpointVersion) {
+        std::cerr << "Error: " << fileName << " is not a checkpoint of this version." << std::endl;
+        return std::nullopt;
+    }
+
+    Checkpoint checkpoint;
+    int32_t nextIteration, nextSolutionIndex, numberOfSolutions, numberOfVertices, numberOfWorkers;
+    bool complete = readValue(file, algorithm) &&
+                    readValue(file, checkpoint.elapsedSeconds) &&
+                    readValue(file, nextIteration) &&
+                    readValue(file, nextSolutionIndex) &&
+                    readValue(file, numberOfSolutions) &&
+                    readValue(file, numberOfVertices);
+
+    // The counts decide how much is allocated, so they have to fit into the rest of the file
+    int64_t remainingBytes = complete ? bytesUntilEnd(file) : 0;
+    if (complete && ((algorithm != FIXED_SET_SEARCH && algorithm != DIVERSE_POOL_SEARCH) || nextIteration < 0 || nextSolutionIndex < 0 ||
+                     numberOfSolutions < 0 || numberOfVertices < 0 ||
+                     static_cast<int64_t>(numberOfSolutions) * (static_cast<int64_t>(numberOfVertices) + 1) * static_cast<int64_t>(sizeof(int32_t)) > remainingBytes)) {
+        std::cerr << "Error: The checkpoint file " << fileName << " is corrupted." << std::endl;
+        return std::nullopt;
+    }
+
+    checkpoint.algorithm = static_cast<Algorithm>(algorithm);
+    checkpoint.nextIteration = nextIteration;
+    checkpoint.nextSolutionIndex = nextSolutionIndex;
+
+    for (int i = 0; complete && i < numberOfSolutions; ++i) {
+        int32_t value;
+        std::vector<int> cliqueIndexForVertex(numberOfVertices);
+        complete = readValue(file, value) &&
+                   file.read(reinterpret_cast<char*>(cliqueIndexForVertex.data()), numberOfVertices * sizeof(int32_t));
+        checkpoint.solutions.push_back({std::move(cliqueIndexForVertex), value});
+    }
+
+    complete = complete && readValue(file, numberOfWorkers);
+    const int64_t bytesPerWorker = 2 * sizeof(int32_t) + sizeof(RandomNumberGenerator::State);
+    if (complete && (numberOfWorkers < 0 || numberOfWorkers * bytesPerWorker > bytesUntilEnd(file))) {
+        std::cerr << "Error: The checkpoint file " << fileName << " is corrupted." << std::endl;
+        return std::nullopt;
+    }
+
+    for (int i = 0; complete && i < numberOfWorkers; ++i) {
+        int32_t portionIndex, stagnationCounter;
+        WorkerState workerState;
+        complete = readValue(file, portionIndex) &&
+                   readValue(file, stagnationCounter) &&
+                   readValue(file, workerState.randomNumberGeneratorState);
+        if (complete && (portionIndex < 0 || stagnationCounter < 0)) {
+            std::cerr << "Error: The checkpoint file " << fileName << " is corrupted." << std::endl;
+            return std::nullopt;
+        }
+        workerState.portionIndex = portionIndex;
+        workerState.stagnationCounter = stagnationCounter;
+        checkpoint.workerStates.push_back(workerState);
+    }
+
+    if (!complete) {
+        std::cerr << "Error: The checkpoint file " << fileName << " is incomplete." << std::endl;
+        return std::nullopt;
+    }
+
+    return checkpoint;
+}
+
+bool Checkpoint::fitsProblem(int numberOfVertices) const {
+    if (solutions.empty()) {
+        return false;
+    }
+    for (const auto& [cliqueIndexForVertex, value] : solutions) {
+        if (cliqueIndexForVertex.size() != numberOfVertices) {
+            return false;
+        }
+        for (int cliqueIndex : cliqueIndexForVertex) {
+            if (cliqueIndex < -1 || cliqueIndex >= numberOfVertices) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+CheckpointWriter::CheckpointWriter(std::string fileName)
+    : fileName(std::move(fileName)), writingThread(&CheckpointWriter::writeLoop, this) {
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    checkpointAvailable.notify_one();
+    writingThread.join();
+}
+
+void CheckpointWriter::submit(Checkpoint checkpoint) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingCheckpoint = std::move(checkpoint);
+    }
+    checkpointAvailable.notify_one();
+}
+
+void CheckpointWriter::writeLoop() {
+    while (true) {
+        Checkpoint checkpoint;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            checkpointAvailable.wait(lock, [this]() { return stopping || pendingCheckpoint.has_value(); });
+            if (!pendingCheckpoint.has_value()) {
+                return;
+            }
+            checkpoint = std::move(*pendingCheckpoint);
+            pendingCheckpoint.reset();
+        }
+        Checkpoint::write(fileName, checkpoint);
+    }
+}
@@ -0,0 +1,57 @@
+#include "CoMembershipSketch.h"
+
+#include <bitset>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+CoMembershipSketch::CoMembershipSketch(const Partition& partition,
+                                       const std::vector<std::pair<int, int>>& sampledPairs) {
+    for (int i = 0; i < sampledPairs.size(); ++i) {
+        auto [vertex1, vertex2] = sampledPairs[i];
+        if (partition.cliqueIndexForVertex(vertex1) == partition.cliqueIndexForVertex(vertex2)) {
+            bits[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+}
+
+std::vector<std::pair<int, int>> CoMembershipSketch::samplePairs(int numberOfVertices) {
+    std::vector<std::pair<int, int>> sampledPairs;
+    if (numberOfVertices < 2) {
+        return sampledPairs;
+    }
+
+    // A generator of its own with a fixed seed, so that the random numbers of the search are not affected
+    std::mt19937_64 generator(numberOfVertices);
+    std::uniform_int_distribution<int> vertexDistribution(0, numberOfVertices - 1);
+    while (sampledPairs.size() < numberOfSampledPairs) {
+        int vertex1 = vertexDistribution(generator);
+        int vertex2 = vertexDistribution(generator);
+        if (vertex1 != vertex2) {
+            sampledPairs.push_back({vertex1, vertex2});
+        }
+    }
+    return sampledPairs;
+}
+
+bool CoMembershipSketch::sharesBand(const CoMembershipSketch& other) const {
+    const uint64_t bandMask = (uint64_t(1) << bitsPerBand) - 1;
+    for (int word = 0; word < bits.size(); ++word) {
+        uint64_t differingBits = bits[word] ^ other.bits[word];
+        for (int band = 0; band < 64 / bitsPerBand; ++band) {
+            if (((differingBits >> (band * bitsPerBand)) & bandMask) == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int CoMembershipSketch::hammingDistance(const CoMembershipSketch& other) const {
+    int distance = 0;
+    for (int word = 0; word < bits.size(); ++word) {
+        distance += std::bitset<64>(bits[word] ^ other.bits[word]).count();
+    }
+    return distance;
+}
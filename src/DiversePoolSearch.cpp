@@ -5,19 +5,43 @@
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <string>
 
+#include "Checkpoint.h"
 #include "GRASP.h"
 #include "GreedyAdding.h"
 #include "GreedyMoving.h"
 #include "PartitionDistances.h"
+#include "RandomNumberGenerator.h"
 #include "SimulatedAnnealing.h"
 #include "SolutionClass.h"
 #include "SolutionManager.h"
+#include "ThreadPool.h"
 #include "partition-comparison.hxx"
-#include "utils.h"
 
-std::vector<std::list<int>> DiversePoolSearch::run(
+/**
+ * If a file name is set, the state of the search is written to this file every checkpointIntervalSeconds
+ * and at the end, from where it can be continued with resume.
+ */
+std::string DiversePoolSearch::checkpointFileName = "";
+double DiversePoolSearch::checkpointIntervalSeconds = 60.0;
+
+/**
+ * Improves all solutions of the pool at the same time instead of one after the other.
+ * The new solutions are compared with the pool at the start of the sweep,
+ * and added in the order of the pool, so that the result doesn't depend on the number of threads.
+ */
+bool DiversePoolSearch::parallelPoolSweep = false;
+
+// Number of reheated SA runs in tryImproveSolution that are started at once on up to numberOfThreads threads, 1 runs them one after the other
+int DiversePoolSearch::numberOfSpeculativeReheats = 1;
+
+// If set, it is called with the best value at the start of the search, on every new best solution and at the end
+SearchProgressCallback DiversePoolSearch::progressCallback;
+
+Partition DiversePoolSearch::run(
     const std::vector<int>& vertices,
     const std::vector<std::vector<int>>& weights,
     int numberOfTotalIterations,
@@ -30,12 +54,17 @@ std::vector<std::list<int>> DiversePoolSearch::run(
     double cooldownFactor,
     double minimalTransitionRatio,
     int lengthOfRandomCandidateList,
-    int numberOfGraspIterations) {
+    int numberOfGraspIterations,
+    int numberOfThreads,
+    const CancellationToken& cancellationToken) {
     auto startTime = std::chrono::high_resolution_clock::now();
 
+    // The time limit is checked by every stage, so that the search stops right when it is reached
+    CancellationToken timeLimitToken = cancellationToken.childToken(CancellationToken::Clock::now() + std::chrono::seconds(timeLimit));
+
     // Initialize best solution and solutions list
-    SolutionWithValueAndIndexLookup bestSolutionWithValues;
-    std::vector<SolutionWithValueAndIndexLookup> solutionsWithValues;
+    SharedSolution bestSolutionWithValues;
+    std::vector<SharedSolution> solutionsWithValues;
 
     // Adjust GRASP iterations
     if (numberOfGraspIterations == -1) {
@@ -51,52 +80,259 @@ std::vector<std::list<int>> DiversePoolSearch::run(
         initialTemperature,
         batchSizeScaleFactor,
         cooldownFactor,
-        minimalTransitionRatio);
+        minimalTransitionRatio,
+        numberOfThreads,
+        timeLimitToken);
 
     // Filter out similar solutions
-    solutionsWithValues = DiversePoolSearch::filterSimilarSolutions(solutionsWithValues, 0.01f);
+    solutionsWithValues = DiversePoolSearch::filterSimilarSolutions(solutionsWithValues, 0.01f, numberOfThreads);
+
+    return search(vertices, weights, std::move(solutionsWithValues), std::nullopt, startTime, numberOfTotalIterations, initialTemperature,
+                  batchSizeScaleFactor, resultLogFileName, desiredSize, improvementFactor, cooldownFactor, minimalTransitionRatio, numberOfThreads,
+                  timeLimitToken);
+}
+
+Partition DiversePoolSearch::resume(
+    const std::string& checkpointFileName,
+    const std::vector<int>& vertices,
+    const std::vector<std::vector<int>>& weights,
+    int numberOfTotalIterations,
+    int timeLimit,
+    double initialTemperature,
+    double batchSizeScaleFactor,
+    const std::string& resultLogFileName,
+    int desiredSize,
+    int improvementFactor,
+    double cooldownFactor,
+    double minimalTransitionRatio,
+    int numberOfThreads,
+    const CancellationToken& cancellationToken) {
+    std::optional<Checkpoint> checkpoint = Checkpoint::read(checkpointFileName);
+    if (!checkpoint || checkpoint->algorithm != Checkpoint::DIVERSE_POOL_SEARCH || !checkpoint->fitsProblem(vertices.size())) {
+        std::cerr << "Error: " << checkpointFileName << " is no checkpoint of a diverse pool search for this problem." << std::endl;
+        return Partition();
+    }
+
+    // The time limit includes the time before the checkpoint
+    double remainingSeconds = timeLimit - checkpoint->elapsedSeconds;
+    CancellationToken timeLimitToken = cancellationToken.childToken(
+        CancellationToken::Clock::now() + std::chrono::duration_cast<CancellationToken::Clock::duration>(std::chrono::duration<double>(remainingSeconds)));
+
+    std::vector<SharedSolution> initialSolutions;
+    for (auto& [cliqueIndexForVertex, value] : checkpoint->solutions) {
+        initialSolutions.push_back(std::make_shared<const SolutionWithValueAndIndexLookup>(Partition(std::move(cliqueIndexForVertex)), weights));
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    return search(vertices, weights, std::move(initialSolutions), std::move(checkpoint), startTime, numberOfTotalIterations, initialTemperature,
+                  batchSizeScaleFactor, resultLogFileName, desiredSize, improvementFactor, cooldownFactor, minimalTransitionRatio, numberOfThreads,
+                  timeLimitToken);
+}
+
+Partition DiversePoolSearch::search(
+    const std::vector<int>& vertices,
+    const std::vector<std::vector<int>>& weights,
+    std::vector<SharedSolution> initialSolutions,
+    std::optional<Checkpoint> checkpoint,
+    std::chrono::high_resolution_clock::time_point startTime,
+    int numberOfTotalIterations,
+    double initialTemperature,
+    double batchSizeScaleFactor,
+    const std::string& resultLogFileName,
+    int desiredSize,
+    int improvementFactor,
+    double cooldownFactor,
+    double minimalTransitionRatio,
+    int numberOfThreads,
+    const CancellationToken& timeLimitToken) {
+    double previouslyElapsedSeconds = 0.0;
+    int firstIteration = 0;
+    int firstSolutionIndex = 0;
+
+    // Continue right after the last solution that was improved before the checkpoint
+    if (checkpoint) {
+        previouslyElapsedSeconds = checkpoint->elapsedSeconds;
+        firstIteration = checkpoint->nextIteration;
+        firstSolutionIndex = checkpoint->nextSolutionIndex;
+        if (!checkpoint->workerStates.empty()) {
+            RandomNumberGenerator::setState(checkpoint->workerStates[0].randomNumberGeneratorState);
+        }
+    }
 
     // Create a solution manager
     SolutionManager solutionManager(0.02f, desiredSize);
 
     // Initialize the solution manager with filtered solutions
-    solutionManager.initialize(solutionsWithValues);
+    solutionManager.initialize(std::move(initialSolutions));
+
+    std::unique_ptr<CheckpointWriter> checkpointWriter;
+    if (!checkpointFileName.empty()) {
+        checkpointWriter = std::make_unique<CheckpointWriter>(checkpointFileName);
+    }
+    auto nextCheckpointTime = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(checkpointIntervalSeconds));
+
+    auto createCheckpoint = [&](int nextIteration, int nextSolutionIndex) {
+        Checkpoint newCheckpoint;
+        newCheckpoint.algorithm = Checkpoint::DIVERSE_POOL_SEARCH;
+        newCheckpoint.elapsedSeconds = previouslyElapsedSeconds + std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+        newCheckpoint.nextIteration = nextIteration;
+        newCheckpoint.nextSolutionIndex = nextSolutionIndex;
+        for (const SharedSolution& solution : solutionManager.getAllSolutions()) {
+            newCheckpoint.solutions.push_back({solution->cliqueIndexForVertexLookup(), solution->value});
+        }
+        newCheckpoint.workerStates.push_back({0, 0, RandomNumberGenerator::getState()});
+        return newCheckpoint;
+    };
+
+    // Position of the solution that is improved, for the checkpoint at the end
+    int nextIteration = firstIteration;
+    int nextSolutionIndex = firstSolutionIndex;
+
+    auto elapsedSeconds = [&]() {
+        auto currentTime = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count() + previouslyElapsedSeconds;
+    };
+
+    // Every solution of the pool that simulated annealing was run on counts as an iteration
+    int completedIterations = 0;
+    int reportedBestValue = solutionManager.getBestSolution()->value;
+
+    auto reportProgress = [&](bool finished) {
+        if (progressCallback) {
+            double secondsSinceStart = previouslyElapsedSeconds + std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+            progressCallback({solutionManager.getBestSolution()->value, secondsSinceStart, completedIterations, finished});
+        }
+    };
+    reportProgress(false);
+
+    auto addSolution = [&](SharedSolution newSolution) {
+        solutionManager.tryAddSolution(std::move(newSolution), elapsedSeconds());
+        if (solutionManager.getBestSolution()->value > reportedBestValue) {
+            reportedBestValue = solutionManager.getBestSolution()->value;
+            reportProgress(false);
+        }
+    };
+
+    auto sweepPoolInParallel = [&](int firstSolutionIndex) {
+        int lastSolutionIndex = std::min<int>(desiredSize, solutionManager.count());
+        std::vector<SharedSolution> poolSolutions(solutionManager.getAllSolutions().begin() + std::min(firstSolutionIndex, lastSolutionIndex),
+                                                  solutionManager.getAllSolutions().begin() + lastSolutionIndex);
+        int numberOfSolutions = poolSolutions.size();
+
+        // Every solution gets its own stream of random numbers
+        uint64_t seed = RandomNumberGenerator::getRandomSeed();
+        std::vector<SharedSolution> newSolutions(numberOfSolutions);
+
+        ThreadPool::shared().parallelFor(
+            numberOfSolutions,
+            [&](int k) {
+                RandomNumberGenerator::ScopedSeed scopedSeed(seed + k);
+                auto [simulatedAnnealingPartition, simulatedAnnealingValue] = SimulatedAnnealing::run(
+                    poolSolutions[k]->partition,
+                    vertices,
+                    weights,
+                    initialTemperature,
+                    batchSizeScaleFactor,
+                    cooldownFactor,
+                    minimalTransitionRatio,
+                    poolSolutions[k]->value,
+                    timeLimitToken);
+                newSolutions[k] = std::make_shared<const SolutionWithValueAndIndexLookup>(std::move(simulatedAnnealingPartition), simulatedAnnealingValue, weights);
+            },
+            numberOfThreads);
+
+        // The solution manager is only used by this thread
+        for (SharedSolution& newSolution : newSolutions) {
+            if (newSolution->value <= solutionManager.getWorstSolution()->value ||
+                solutionManager.existsSimilarSolutionWithHigherValue(*newSolution)) {
+                newSolution.reset();
+            }
+        }
+
+        ThreadPool::shared().parallelFor(
+            numberOfSolutions,
+            [&](int k) {
+                if (newSolutions[k]) {
+                    RandomNumberGenerator::ScopedSeed scopedSeed(seed + numberOfSolutions + k);
+                    newSolutions[k] = DiversePoolSearch::tryImproveSolution(
+                        std::move(newSolutions[k]),
+                        vertices,
+                        weights,
+                        initialTemperature,
+                        batchSizeScaleFactor,
+                        cooldownFactor,
+                        minimalTransitionRatio,
+                        improvementFactor,
+                        numberOfThreads,
+                        timeLimitToken);
+                }
+            },
+            numberOfThreads);
+
+        completedIterations += numberOfSolutions;
+        for (SharedSolution& newSolution : newSolutions) {
+            if (newSolution) {
+                addSolution(std::move(newSolution));
+            }
+        }
+    };
 
     // Main iteration loop
-    for (int i = 0; i < numberOfTotalIterations; i++) {
-        for (int j = 0; j < desiredSize && j < solutionManager.count(); j++) {
+    for (int i = firstIteration; i < numberOfTotalIterations; i++) {
+        // Check time limit, the inner loop only stops the sweep over the pool
+        if (timeLimitToken.isCancelled()) {
+            break;
+        }
+
+        if (parallelPoolSweep) {
+            nextIteration = i;
+            nextSolutionIndex = i == firstIteration ? firstSolutionIndex : 0;
+            if (checkpointWriter && std::chrono::steady_clock::now() >= nextCheckpointTime) {
+                checkpointWriter->submit(createCheckpoint(nextIteration, nextSolutionIndex));
+                nextCheckpointTime = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(checkpointIntervalSeconds));
+            }
+
+            sweepPoolInParallel(nextSolutionIndex);
+            continue;
+        }
+
+        for (int j = i == firstIteration ? firstSolutionIndex : 0; j < desiredSize && j < solutionManager.count(); j++) {
             // Check time limit
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            double elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count();
-            if (elapsedTime >= timeLimit) {
+            if (timeLimitToken.isCancelled()) {
                 break;
             }
 
-            auto solution = solutionManager.getSolution(j);
-
-            // Get partition
-            auto partition = solution.partition;
+            nextIteration = i;
+            nextSolutionIndex = j;
+            if (checkpointWriter && std::chrono::steady_clock::now() >= nextCheckpointTime) {
+                checkpointWriter->submit(createCheckpoint(i, j));
+                nextCheckpointTime = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(checkpointIntervalSeconds));
+            }
 
+            SharedSolution solution = solutionManager.getSolution(j);
             // Run simulated annealing
-            std::vector<std::list<int>> simulatedAnnealingPartition = SimulatedAnnealing::run(
-                partition,
+            auto [simulatedAnnealingPartition, simulatedAnnealingValue] = SimulatedAnnealing::run(
+                solution->partition,
                 vertices,
                 weights,
                 initialTemperature,
                 batchSizeScaleFactor,
                 cooldownFactor,
-                minimalTransitionRatio);
+                minimalTransitionRatio,
+                solution->value,
+                timeLimitToken);
 
-            SolutionWithValueAndIndexLookup newSolution(simulatedAnnealingPartition, weights);
+            SharedSolution newSolution = std::make_shared<const SolutionWithValueAndIndexLookup>(std::move(simulatedAnnealingPartition), simulatedAnnealingValue, weights);
+            completedIterations++;
 
-            if (newSolution.value <= solutionManager.getWorstSolution().value) {
+            if (newSolution->value <= solutionManager.getWorstSolution()->value) {
                 continue;
             }
 
             // Skip if similar solution with higher value exists.
             // This is especially also the case, if the solution returned by SA
             // is the same as the solution from the pool it was based on.
-            if (solutionManager.existsSimilarSolutionWithHigherValue(newSolution)) {
+            if (solutionManager.existsSimilarSolutionWithHigherValue(*newSolution)) {
                 continue;
             }
 
@@ -104,44 +340,58 @@ std::vector<std::list<int>> DiversePoolSearch::run(
 
             // Try to improve the solution
             newSolution = DiversePoolSearch::tryImproveSolution(
-                newSolution,
+                std::move(newSolution),
                 vertices,
                 weights,
                 initialTemperature,
                 batchSizeScaleFactor,
                 cooldownFactor,
                 minimalTransitionRatio,
-                improvementFactor);
+                improvementFactor,
+                numberOfThreads,
+                timeLimitToken);
 
             // std::cout << newSolution.value << std::endl;
 
             // Try to add the solution
-            elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count();
-            solutionManager.tryAddSolution(newSolution, elapsedTime);
+            addSolution(std::move(newSolution));
         }
     }
 
+    if (checkpointWriter) {
+        // The solution that was improved when the time limit was reached is improved again after resuming
+        if (!timeLimitToken.isCancelled()) {
+            nextIteration = numberOfTotalIterations;
+            nextSolutionIndex = 0;
+        }
+        checkpointWriter->submit(createCheckpoint(nextIteration, nextSolutionIndex));
+    }
+
+    reportProgress(true);
+
     // Log results
     logResults(resultLogFileName, solutionManager.getAllSolutions());
 
     // Return the best solution
-    return solutionManager.getBestSolution().partition;
+    return solutionManager.getBestSolution()->partition;
 }
 
 // Helper function to try to improve a solution
-SolutionWithValueAndIndexLookup DiversePoolSearch::tryImproveSolution(
-    const SolutionWithValueAndIndexLookup& solution,
+SharedSolution DiversePoolSearch::tryImproveSolution(
+    SharedSolution solution,
     const std::vector<int>& vertices,
     const std::vector<std::vector<int>>& weights,
     double initialTemperature,
     double batchSizeScaleFactor,
     double cooldownFactor,
     double minimalTransitionRatio,
-    int improvementFactor) {
-    SolutionWithValueAndIndexLookup improvedSolution = solution;
+    int improvementFactor,
+    int numberOfThreads,
+    const CancellationToken& cancellationToken) {
+    SharedSolution improvedSolution = std::move(solution);
     bool improving = true;
 
-    while (improving) {
+    while (improving && !cancellationToken.isCancelled()) {
         improving = false;
         std::vector<float> multipliers;
 
@@ -150,21 +400,31 @@ SolutionWithValueAndIndexLookup DiversePoolSearch::tryImproveSolution(
         multipliers.insert(multipliers.end(), improvementFactor, 36.0f);
         multipliers.insert(multipliers.end(), improvementFactor, 24.0f);
 
+        if (numberOfSpeculativeReheats > 1) {
+            improving = tryImproveSpeculatively(improvedSolution, multipliers, vertices, weights, initialTemperature, batchSizeScaleFactor,
+                                                cooldownFactor, minimalTransitionRatio, numberOfThreads, cancellationToken);
+            continue;
+        }
+
         for (auto multiplier : multipliers) {
+            if (cancellationToken.isCancelled()) {
+                break;
+            }
+
             double improveTemp = initialTemperature * std::pow(cooldownFactor, multiplier);
-            std::vector<std::list<int>> tempPartition = SimulatedAnnealing::run(
-                improvedSolution.partition,
+            auto [tempPartition, value] = SimulatedAnnealing::run(
+                improvedSolution->partition,
                 vertices,
                 weights,
                 improveTemp,
                 batchSizeScaleFactor,
                 cooldownFactor,
-                minimalTransitionRatio);
-
-            int value = utils::valueForPartition(tempPartition, weights);
+                minimalTransitionRatio,
+                improvedSolution->value,
+                cancellationToken);
 
-            if (value > improvedSolution.value) {
-                improvedSolution = SolutionWithValueAndIndexLookup(tempPartition, weights);
+            if (value > improvedSolution->value) {
+                improvedSolution = std::make_shared<const SolutionWithValueAndIndexLookup>(std::move(tempPartition), value, weights);
                 improving = true;
                 // std::cout << "Improved solution to: " << value << " at multiplier " << multiplier << std::endl;
                 break;
@@ -175,32 +435,86 @@ SolutionWithValueAndIndexLookup DiversePoolSearch::tryImproveSolution(
     return improvedSolution;
 }
 
+// Runs the reheats in batches, and takes the first one that improves the solution
+bool DiversePoolSearch::tryImproveSpeculatively(
+    SharedSolution& solution,
+    const std::vector<float>& multipliers,
+    const std::vector<int>& vertices,
+    const std::vector<std::vector<int>>& weights,
+    double initialTemperature,
+    double batchSizeScaleFactor,
+    double cooldownFactor,
+    double minimalTransitionRatio,
+    int numberOfThreads,
+    const CancellationToken& cancellationToken) {
+    for (int first = 0; first < multipliers.size() && !cancellationToken.isCancelled(); first += numberOfSpeculativeReheats) {
+        int batchSize = std::min<int>(numberOfSpeculativeReheats, multipliers.size() - first);
+
+        // Every reheat gets its own stream of random numbers and can be stopped on its own
+        uint64_t seed = RandomNumberGenerator::getRandomSeed();
+        std::vector<CancellationToken> reheatTokens;
+        for (int k = 0; k < batchSize; ++k) {
+            reheatTokens.push_back(cancellationToken.childToken());
+        }
+        std::vector<std::pair<Partition, int>> results(batchSize);
+
+        ThreadPool::shared().parallelFor(
+            batchSize,
+            [&](int k) {
+                RandomNumberGenerator::ScopedSeed scopedSeed(seed + k);
+                double improveTemp = initialTemperature * std::pow(cooldownFactor, multipliers[first + k]);
+                results[k] = SimulatedAnnealing::run(
+                    solution->partition,
+                    vertices,
+                    weights,
+                    improveTemp,
+                    batchSizeScaleFactor,
+                    cooldownFactor,
+                    minimalTransitionRatio,
+                    solution->value,
+                    reheatTokens[k]);
+
+                // Only the first improving reheat of the batch is used, so the ones behind it can stop.
+                // The ones before it keep running, which makes the choice independent of the timing.
+                if (results[k].second > solution->value) {
+                    for (int later = k + 1; later < batchSize; ++later) {
+                        reheatTokens[later].cancel();
+                    }
+                }
+            },
+            std::min(batchSize, numberOfThreads));
+
+        for (auto& [partition, value] : results) {
+            if (value > solution->value) {
+                solution = std::make_shared<const SolutionWithValueAndIndexLookup>(std::move(partition), value, weights);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
 // Helper function to filter similar solutions
-std::vector<SolutionWithValueAndIndexLookup> DiversePoolSearch::filterSimilarSolutions(
-    const std::vector<SolutionWithValueAndIndexLookup>& solutions,
-    float similarityThreshold) {
+std::vector<SharedSolution> DiversePoolSearch::filterSimilarSolutions(
+    const std::vector<SharedSolution>& solutions,
+    float similarityThreshold,
+    int numberOfThreads) {
     // Extract clique index for each vertex from solutions
     std::vector<std::vector<int>> cliqueIndexForVertexList;
     for (const auto& solution : solutions) {
-        cliqueIndexForVertexList.push_back(solution.cliqueIndexForVertex);
+        cliqueIndexForVertexList.push_back(solution->cliqueIndexForVertexLookup());
     }
 
     // Compute distances between solutions
-    std::vector<std::vector<float>> distances = computeUpperDistanceMatrix(cliqueIndexForVertexList, Metric::RAND_ERROR);
-
-    // Make distance matrix symmetric
-    for (int i = 0; i < distances.size(); ++i) {
-        for (int j = i + 1; j < distances.size(); ++j) {
-            distances[j][i] = distances[i][j];
-        }
-    }
+    CondensedDistanceMatrix distances = computeDistanceMatrix(cliqueIndexForVertexList, Metric::RAND_ERROR, numberOfThreads);
 
     // Filter solutions by removing similar ones with lower values
-    std::vector<SolutionWithValueAndIndexLookup> filteredSolutions;
+    std::vector<SharedSolution> filteredSolutions;
     for (int i = 0; i < solutions.size(); ++i) {
         bool keep = true;
         for (int j = 0; j < solutions.size(); ++j) {
-            if (i != j && distances[i][j] < similarityThreshold && solutions[i].value < solutions[j].value) {
+            if (i != j && distances(i, j) < similarityThreshold && solutions[i]->value < solutions[j]->value) {
                 keep = false;
                 break;
             }
@@ -216,7 +530,7 @@ std::vector<SolutionWithValueAndIndexLookup> DiversePoolSearch::filterSimilarSol
 // Helper function to log results
 void DiversePoolSearch::logResults(
     const std::string& resultLogFileName,
-    const std::vector<SolutionWithValueAndIndexLookup>& solutions) {
+    const std::vector<SharedSolution>& solutions) {
     // if no log file name is provided, return
     if (resultLogFileName.empty()) {
         return;
@@ -225,7 +539,7 @@ void DiversePoolSearch::logResults(
     std::ofstream outFile(resultLogFileName);
     if (outFile.is_open()) {
         for (const auto& solution : solutions) {
-            outFile << solution.value << std::endl;
+            outFile << solution->value << std::endl;
         }
         outFile.close();
     } else {
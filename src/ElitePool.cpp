@@ -0,0 +1,96 @@
+#include "ElitePool.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+ElitePool::ElitePool(int capacity)
+    : maximalNumberOfSolutions(capacity) {
+    sortedSolutions.reserve(capacity);
+}
+
+int ElitePool::size() const {
+    return sortedSolutions.size();
+}
+
+int ElitePool::capacity() const {
+    return maximalNumberOfSolutions;
+}
+
+bool ElitePool::empty() const {
+    return sortedSolutions.empty();
+}
+
+bool ElitePool::full() const {
+    return sortedSolutions.size() >= maximalNumberOfSolutions;
+}
+
+const SharedSolution& ElitePool::operator[](int index) const {
+    return sortedSolutions[index];
+}
+
+const SharedSolution& ElitePool::best() const {
+    return sortedSolutions.front();
+}
+
+const SharedSolution& ElitePool::worst() const {
+    return sortedSolutions.back();
+}
+
+std::vector<SharedSolution>::const_iterator ElitePool::begin() const {
+    return sortedSolutions.begin();
+}
+
+std::vector<SharedSolution>::const_iterator ElitePool::end() const {
+    return sortedSolutions.end();
+}
+
+const std::vector<SharedSolution>& ElitePool::solutions() const {
+    return sortedSolutions;
+}
+
+bool ElitePool::contains(const SolutionWithValueAndIndexLookup& solution) const {
+    return uniqueSolutions.contains(solution);
+}
+
+bool ElitePool::holds(const SharedSolution& solution) const {
+    return std::find(sortedSolutions.begin(), sortedSolutions.end(), solution) != sortedSolutions.end();
+}
+
+int ElitePool::insertPosition(int value) const {
+    auto position = std::upper_bound(sortedSolutions.begin(), sortedSolutions.end(), value,
+                                     [](int value, const SharedSolution& solution) {
+                                         return value > solution->value;
+                                     });
+    return std::distance(sortedSolutions.begin(), position);
+}
+
+bool ElitePool::accepts(const SolutionWithValueAndIndexLookup& solution) const {
+    if (maximalNumberOfSolutions <= 0) {
+        return false;
+    }
+    if (full() && solution.value <= worst()->value) {
+        return false;
+    }
+    return !contains(solution);
+}
+
+bool ElitePool::tryInsert(SharedSolution solution) {
+    if (!accepts(*solution)) {
+        return false;
+    }
+
+    if (full()) {
+        uniqueSolutions.erase(sortedSolutions.back());
+        sortedSolutions.pop_back();
+    }
+
+    uniqueSolutions.insert(solution);
+    sortedSolutions.insert(sortedSolutions.begin() + insertPosition(solution->value), std::move(solution));
+    return true;
+}
+
+void ElitePool::erase(int index) {
+    uniqueSolutions.erase(sortedSolutions[index]);
+    sortedSolutions.erase(sortedSolutions.begin() + index);
+}
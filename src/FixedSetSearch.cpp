@@ -1,149 +1,470 @@
 #include "FixedSetSearch.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <iostream>
-#include <list>
-#include <random>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
+#include "BoundedQueue.h"
+#include "Checkpoint.h"
+#include "ElitePool.h"
 #include "GRASP.h"
+#include "GraphContraction.h"
 #include "GreedyAdding.h"
 #include "GreedyMoving.h"
 #include "PartitionDistances.h"
+#include "PortionScheduler.h"
+#include "RandomNumberGenerator.h"
 #include "SimulatedAnnealing.h"
 #include "SolutionClass.h"
-
-std::vector<std::list<int>> FixedSetSearch::run(const std::vector<int>& vertices,
-                                                const std::vector<std::vector<int>>& weights,
-                                                int numberOfTotalIterations,
-                                                int timeLimit,
-                                                double initialTemperature,
-                                                double batchSizeScaleFactor,
-                                                int m,
-                                                int n,
-                                                int k,
-                                                int maximumStagnationCountPerPortion,
-                                                int numberOfGRASPIterations,
-                                                int lengthOfRandomCandidateList,
-                                                double cooldownFactor,
-                                                double minimalTransitionRatio) {
+#include "ThreadPool.h"
+
+/**
+ * If set, the cliques of the fixed partial solution are contracted into single vertices before the local search,
+ * so that each iteration works on a problem with one vertex per fixed clique plus the free vertices.
+ * The fixed cliques can then only be moved as a whole, but never split up again.
+ */
+bool FixedSetSearch::contractFixedCliques = false;
+
+/**
+ * If set, simulated annealing only picks the vertices that were free in the fixed partial solution,
+ * which saves the steps spent on fixed vertices in the iterations with a large portion of fixed vertices.
+ * The fixed vertices can still move in a relaxation phase at relaxationTemperatureFactor times the initial temperature,
+ * a factor of 0 skips it.
+ */
+bool FixedSetSearch::annealOnlyFreeVertices = false;
+double FixedSetSearch::relaxationTemperatureFactor = 0.1;
+
+/**
+ * If set, every worker has a helper thread that picks the fixed set and runs GreedyAdding and GreedyMoving
+ * for the next iterations, while the worker runs simulated annealing.
+ * A prepared partition is skipped if its base solution was removed from the pool in the meantime.
+ */
+bool FixedSetSearch::pipelinedIterations = false;
+int FixedSetSearch::numberOfPreparedIterations = 2;
+
+/**
+ * If a file name is set, the state of the search is written to this file every checkpointIntervalSeconds
+ * and at the end, from where it can be continued with resume.
+ */
+std::string FixedSetSearch::checkpointFileName = "";
+double FixedSetSearch::checkpointIntervalSeconds = 60.0;
+
+// How the portion of fixed vertices is chosen for each iteration, see PortionScheduler
+PortionScheduler::Strategy FixedSetSearch::portionSchedulingStrategy = PortionScheduler::ROUND_ROBIN;
+
+// If set, it is called with the best value at the start of the search, on every new best solution and at the end
+SearchProgressCallback FixedSetSearch::progressCallback;
+
+// Each portion of fixed vertices with its statistics summed over all workers, set at the end of every search
+std::vector<std::pair<double, PortionScheduler::PortionStatistics>> FixedSetSearch::lastPortionStatistics;
+
+Partition FixedSetSearch::run(const std::vector<int>& vertices,
+                              const std::vector<std::vector<int>>& weights,
+                              int numberOfTotalIterations,
+                              int timeLimit,
+                              double initialTemperature,
+                              double batchSizeScaleFactor,
+                              int m,
+                              int n,
+                              int k,
+                              int maximumStagnationCountPerPortion,
+                              int numberOfGRASPIterations,
+                              int lengthOfRandomCandidateList,
+                              double cooldownFactor,
+                              double minimalTransitionRatio,
+                              int numberOfThreads,
+                              const CancellationToken& cancellationToken) {
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    std::vector<double> fixedSetSizePortions = initializeFixedSetSizePortions(vertices.size());
-    int currentPortionIndex = 0;
-    double currentPortion = fixedSetSizePortions[currentPortionIndex];
+    // The time limit is checked by every stage, so that the search stops right when it is reached
+    CancellationToken timeLimitToken = cancellationToken.childToken(CancellationToken::Clock::now() + std::chrono::seconds(timeLimit));
 
     // store solutions along with their values
-    SolutionWithValueAndIndexLookup bestSolutionWithValues;
-    std::vector<SolutionWithValueAndIndexLookup> solutionsWithValues;
+    SharedSolution bestSolutionWithValues;
+    std::vector<SharedSolution> initialSolutions;
+
+    std::tie(bestSolutionWithValues, initialSolutions) = GRASP::run(numberOfGRASPIterations,
+                                                                    vertices,
+                                                                    weights,
+                                                                    lengthOfRandomCandidateList,
+                                                                    initialTemperature,
+                                                                    batchSizeScaleFactor,
+                                                                    cooldownFactor,
+                                                                    minimalTransitionRatio,
+                                                                    numberOfThreads,
+                                                                    timeLimitToken);
+
+    return search(vertices, weights, std::move(initialSolutions), std::nullopt, startTime, numberOfGRASPIterations, numberOfTotalIterations,
+                  initialTemperature, batchSizeScaleFactor, m, n, k, maximumStagnationCountPerPortion, lengthOfRandomCandidateList, cooldownFactor,
+                  minimalTransitionRatio, numberOfThreads, timeLimitToken);
+}
+
+Partition FixedSetSearch::resume(const std::string& checkpointFileName,
+                                 const std::vector<int>& vertices,
+                                 const std::vector<std::vector<int>>& weights,
+                                 int numberOfTotalIterations,
+                                 int timeLimit,
+                                 double initialTemperature,
+                                 double batchSizeScaleFactor,
+                                 int m,
+                                 int n,
+                                 int k,
+                                 int maximumStagnationCountPerPortion,
+                                 int lengthOfRandomCandidateList,
+                                 double cooldownFactor,
+                                 double minimalTransitionRatio,
+                                 int numberOfThreads,
+                                 const CancellationToken& cancellationToken) {
+    std::optional<Checkpoint> checkpoint = Checkpoint::read(checkpointFileName);
+    if (!checkpoint || checkpoint->algorithm != Checkpoint::FIXED_SET_SEARCH || !checkpoint->fitsProblem(vertices.size())) {
+        std::cerr << "Error: " << checkpointFileName << " is no checkpoint of a fixed set search for this problem." << std::endl;
+        return Partition();
+    }
+
+    // The time limit includes the time before the checkpoint
+    double remainingSeconds = timeLimit - checkpoint->elapsedSeconds;
+    CancellationToken timeLimitToken = cancellationToken.childToken(
+        CancellationToken::Clock::now() + std::chrono::duration_cast<CancellationToken::Clock::duration>(std::chrono::duration<double>(remainingSeconds)));
+
+    std::vector<SharedSolution> initialSolutions;
+    for (auto& [cliqueIndexForVertex, value] : checkpoint->solutions) {
+        initialSolutions.push_back(std::make_shared<const SolutionWithValueAndIndexLookup>(Partition(std::move(cliqueIndexForVertex)), weights));
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    int firstIteration = checkpoint->nextIteration;
+    return search(vertices, weights, std::move(initialSolutions), std::move(checkpoint), startTime, firstIteration, numberOfTotalIterations,
+                  initialTemperature, batchSizeScaleFactor, m, n, k, maximumStagnationCountPerPortion, lengthOfRandomCandidateList, cooldownFactor,
+                  minimalTransitionRatio, numberOfThreads, timeLimitToken);
+}
+
+Partition FixedSetSearch::search(const std::vector<int>& vertices,
+                                 const std::vector<std::vector<int>>& weights,
+                                 std::vector<SharedSolution> initialSolutions,
+                                 std::optional<Checkpoint> checkpoint,
+                                 std::chrono::high_resolution_clock::time_point startTime,
+                                 int firstIteration,
+                                 int numberOfTotalIterations,
+                                 double initialTemperature,
+                                 double batchSizeScaleFactor,
+                                 int m,
+                                 int n,
+                                 int k,
+                                 int maximumStagnationCountPerPortion,
+                                 int lengthOfRandomCandidateList,
+                                 double cooldownFactor,
+                                 double minimalTransitionRatio,
+                                 int numberOfThreads,
+                                 const CancellationToken& timeLimitToken) {
+    double previouslyElapsedSeconds = checkpoint ? checkpoint->elapsedSeconds : 0.0;
+
+    std::vector<double> fixedSetSizePortions = initializeFixedSetSizePortions(vertices.size());
     int numberOfSolutionsToStore = std::max(n, m);
 
-    std::tie(bestSolutionWithValues, solutionsWithValues) = GRASP::run(numberOfGRASPIterations,
-                                                                       vertices,
-                                                                       weights,
-                                                                       lengthOfRandomCandidateList,
-                                                                       initialTemperature,
-                                                                       batchSizeScaleFactor,
-                                                                       cooldownFactor,
-                                                                       minimalTransitionRatio);
-
-    int stagnationCounter = 0;
-
-    // boolean to track, whether we need to sort the list of solutions again
-    bool addedPartitionToSolutions = true;
-
-    for (int iteration = numberOfGRASPIterations; iteration < numberOfTotalIterations; ++iteration) {
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        double elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count();
-        if (elapsedTime >= timeLimit) {
-            break;
+    // The pool keeps the solutions sorted by their values and finds out quickly whether a new solution is already known
+    ElitePool initialPool(numberOfSolutionsToStore);
+    for (auto& solution : initialSolutions) {
+        initialPool.tryInsert(std::move(solution));
+    }
+    SharedSolution bestSolutionWithValues = initialPool.best();
+
+    // The workers only read snapshots of the pool, which are never changed once they are published.
+    // Changes are made to a copy under the mutex, which then replaces the snapshot.
+    std::shared_ptr<const ElitePool> solutionsWithValues = std::make_shared<const ElitePool>(std::move(initialPool));
+    std::mutex solutionsMutex;
+
+    std::atomic<int> nextIteration(firstIteration);
+    std::atomic<int> completedIterations(0);
+
+    // Only called under the mutex or when no worker is running, so that the reports never overlap
+    auto reportProgress = [&](bool finished) {
+        if (progressCallback) {
+            double secondsSinceStart = previouslyElapsedSeconds + std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+            progressCallback({bestSolutionWithValues->value, secondsSinceStart, completedIterations.load(), finished});
         }
+    };
+    reportProgress(false);
 
-        if (addedPartitionToSolutions) {
-            // Sort solutions by their values
-            std::sort(solutionsWithValues.begin(), solutionsWithValues.end(),
-                      [](const SolutionWithValueAndIndexLookup& a, const SolutionWithValueAndIndexLookup& b) {
-                          return a.value > b.value;
-                      });
+    // statistics of all workers, summed up when they are done
+    std::vector<PortionScheduler::PortionStatistics> portionStatistics(fixedSetSizePortions.size());
+
+    // Every worker gets its own stream of random numbers
+    uint64_t seed = RandomNumberGenerator::getRandomSeed();
+
+    // State of the workers for the checkpoints, only accessed under the mutex
+    std::vector<Checkpoint::WorkerState> workerStates(numberOfThreads);
+    if (checkpoint) {
+        std::copy_n(checkpoint->workerStates.begin(), std::min<size_t>(numberOfThreads, checkpoint->workerStates.size()), workerStates.begin());
+    }
+
+    std::unique_ptr<CheckpointWriter> checkpointWriter;
+    if (!checkpointFileName.empty()) {
+        checkpointWriter = std::make_unique<CheckpointWriter>(checkpointFileName);
+    }
+    auto nextCheckpointTime = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(checkpointIntervalSeconds));
+
+    auto createCheckpoint = [&]() {
+        Checkpoint newCheckpoint;
+        newCheckpoint.algorithm = Checkpoint::FIXED_SET_SEARCH;
+        newCheckpoint.elapsedSeconds = previouslyElapsedSeconds + std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+        newCheckpoint.nextIteration = std::min(nextIteration.load(), numberOfTotalIterations);
+        for (const SharedSolution& solution : *std::atomic_load(&solutionsWithValues)) {
+            newCheckpoint.solutions.push_back({solution->cliqueIndexForVertexLookup(), solution->value});
         }
+        newCheckpoint.workerStates = workerStates;
+        return newCheckpoint;
+    };
+
+    auto worker = [&](int workerIndex) {
+        RandomNumberGenerator::ScopedSeed scopedSeed(seed + workerIndex);
 
-        int currentNumberOfSolutions = static_cast<int>(solutionsWithValues.size());
-        int m_restricted = std::min(m, currentNumberOfSolutions);  // to choose base solution from
-        int n_restricted = std::min(n, currentNumberOfSolutions);  // to choose k solutions from
-        int k_restricted = std::min(k, currentNumberOfSolutions);  // to choose solutions for building the fixed partial solution
-
-        // copy the solutions to a new vector, choose the n best and shuffle them to get k random solutions for the fixed partial solution
-        std::vector<SolutionWithValueAndIndexLookup> solutionsForFixedSet(solutionsWithValues.begin(), solutionsWithValues.begin() + n_restricted);
-        shuffleVector(solutionsForFixedSet);
-        solutionsForFixedSet.resize(k_restricted);
-
-        // Select the m best solutions for base solution
-        std::vector<SolutionWithValueAndIndexLookup> solutionsForBaseSolution(solutionsWithValues.begin(), solutionsWithValues.begin() + m_restricted);
-        int index = rand() % solutionsForBaseSolution.size();
-        const std::vector<std::list<int>>& baseSolution = solutionsForBaseSolution[index].partition;
-
-        double duration;
-
-        // Find fixed partial solution
-        std::vector<std::list<int>> fixedPartialSolution;
-        fixedPartialSolution = findFixedPartialSolution(baseSolution, solutionsForFixedSet, currentPortion);
-
-        // Perform GRASP and local search on the new partition
-        std::vector<std::list<int>> partition;
-        partition = GreedyAdding::run(vertices, weights, fixedPartialSolution, lengthOfRandomCandidateList);
-        partition = GreedyMoving::run(vertices, weights, partition);
-        partition = SimulatedAnnealing::run(partition, vertices, weights, initialTemperature, batchSizeScaleFactor, cooldownFactor, minimalTransitionRatio);
-
-        auto newSolution = SolutionWithValueAndIndexLookup(partition, weights);
-
-        // add the solution, if it is not already in the solutionsWithValues vector
-        bool newUniqueSolution = std::none_of(solutionsWithValues.begin(), solutionsWithValues.end(),
-                                              [&](const SolutionWithValueAndIndexLookup& sol) { return sol == newSolution; });
-
-        int currentWorstValue = solutionsWithValues.back().value;
-        bool improvedValue = newSolution.value > currentWorstValue;
-
-        bool solutionsFull = solutionsWithValues.size() >= numberOfSolutionsToStore;
-
-        if (newUniqueSolution && !solutionsFull) {
-            solutionsWithValues.push_back(newSolution);
-            addedPartitionToSolutions = true;
-        } else if (newUniqueSolution && improvedValue) {
-            solutionsWithValues.pop_back();
-            solutionsWithValues.push_back(newSolution);
-            addedPartitionToSolutions = true;
-        } else {
-            addedPartitionToSolutions = false;
+        // Each worker chooses its portions on its own, starting at different portions
+        PortionScheduler portionScheduler(fixedSetSizePortions, portionSchedulingStrategy, maximumStagnationCountPerPortion, workerIndex);
+
+        // Continue with the state of the worker from the checkpoint
+        if (checkpoint && workerIndex < checkpoint->workerStates.size()) {
+            const Checkpoint::WorkerState& workerState = checkpoint->workerStates[workerIndex];
+            portionScheduler.restore(workerState.portionIndex, workerState.stagnationCounter);
+            RandomNumberGenerator::setState(workerState.randomNumberGeneratorState);
+        }
+
+        std::atomic<int> currentPortionIndex(portionScheduler.currentPortionIndex());
+
+        // In the pipelined mode, a helper thread prepares the next partitions while the worker runs simulated annealing
+        std::unique_ptr<BoundedQueue<PreparedIteration>> preparedIterations;
+        std::thread preparingThread;
+        if (pipelinedIterations) {
+            preparedIterations = std::make_unique<BoundedQueue<PreparedIteration>>(numberOfPreparedIterations);
+            preparingThread = std::thread([&, workerIndex]() {
+                RandomNumberGenerator::seed(seed + numberOfThreads + workerIndex);
+                while (true) {
+                    int portionIndex = currentPortionIndex;
+                    if (!preparedIterations->push(prepareIteration(*std::atomic_load(&solutionsWithValues), vertices, weights, m, n, k, portionIndex, fixedSetSizePortions[portionIndex], lengthOfRandomCandidateList, timeLimitToken))) {
+                        break;
+                    }
+                }
+            });
         }
 
-        // Update the best solution if a better one is found
-        if (newSolution.value > bestSolutionWithValues.value) {
-            elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count();
-            std::cout << "New best: " << newSolution.value << "    Iteration: " << iteration << "    Time: " << elapsedTime << " seconds." << std::endl;
-            bestSolutionWithValues = newSolution;
-            stagnationCounter = 0;
-        } else {
-            stagnationCounter++;
+        int iteration;
+        while ((iteration = nextIteration.fetch_add(1)) < numberOfTotalIterations) {
+            if (timeLimitToken.isCancelled()) {
+                break;
+            }
+
+            auto iterationStartTime = std::chrono::steady_clock::now();
+
+            std::optional<PreparedIteration> preparedIteration;
+            if (pipelinedIterations) {
+                // Skip partitions whose base solution was replaced in the meantime, they were built from an outdated pool
+                while ((preparedIteration = preparedIterations->pop()) && isOutdated(*preparedIteration, *std::atomic_load(&solutionsWithValues))) {
+                }
+                if (!preparedIteration) {
+                    break;
+                }
+            } else {
+                int portionIndex = portionScheduler.currentPortionIndex();
+                preparedIteration = prepareIteration(*std::atomic_load(&solutionsWithValues), vertices, weights, m, n, k, portionIndex, fixedSetSizePortions[portionIndex], lengthOfRandomCandidateList, timeLimitToken);
+            }
+
+            // Perform local search on the prepared partition
+            Partition partition;
+            int value;
+            std::tie(partition, value) = finishIteration(*preparedIteration,
+                                                         vertices,
+                                                         weights,
+                                                         initialTemperature,
+                                                         batchSizeScaleFactor,
+                                                         cooldownFactor,
+                                                         minimalTransitionRatio,
+                                                         timeLimitToken);
+
+            auto newSolution = std::make_shared<const SolutionWithValueAndIndexLookup>(std::move(partition), value, weights);
+            int improvement = value - preparedIteration->baseSolution->value;
+            std::chrono::duration<double> iterationDuration = std::chrono::steady_clock::now() - iterationStartTime;
+            completedIterations++;
+
+            bool foundNewBest = false;
+            {
+                std::lock_guard<std::mutex> lock(solutionsMutex);
+                // add the solution, if it is not already in the pool and better than the worst solution of a full pool
+                if (solutionsWithValues->accepts(*newSolution)) {
+                    auto updatedSolutions = std::make_shared<ElitePool>(*solutionsWithValues);
+                    updatedSolutions->tryInsert(newSolution);
+
+                    std::atomic_store(&solutionsWithValues, std::shared_ptr<const ElitePool>(std::move(updatedSolutions)));
+                }
+
+                // Update the best solution if a better one is found
+                if (newSolution->value > bestSolutionWithValues->value) {
+                    auto currentTime = std::chrono::high_resolution_clock::now();
+                    double elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - startTime).count() + previouslyElapsedSeconds;
+                    std::cout << "New best: " << newSolution->value << "    Iteration: " << iteration << "    Time: " << elapsedTime << " seconds." << std::endl;
+                    bestSolutionWithValues = std::move(newSolution);
+                    foundNewBest = true;
+                    reportProgress(false);
+                }
+            }
+
+            portionScheduler.recordIteration(preparedIteration->portionIndex, improvement, foundNewBest, iterationDuration.count());
+            currentPortionIndex = portionScheduler.currentPortionIndex();
+
+            std::optional<Checkpoint> newCheckpoint;
+            {
+                std::lock_guard<std::mutex> lock(solutionsMutex);
+                workerStates[workerIndex] = {portionScheduler.currentPortionIndex(), portionScheduler.stagnationCount(), RandomNumberGenerator::getState()};
+
+                if (checkpointWriter && std::chrono::steady_clock::now() >= nextCheckpointTime) {
+                    newCheckpoint = createCheckpoint();
+                    nextCheckpointTime = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(checkpointIntervalSeconds));
+                }
+            }
+
+            // The checkpoint is written by another thread
+            if (newCheckpoint) {
+                checkpointWriter->submit(std::move(*newCheckpoint));
+            }
         }
 
-        // Adjust portion and reset stagnation counter if needed
-        if (stagnationCounter >= maximumStagnationCountPerPortion) {
-            currentPortionIndex = (currentPortionIndex + 1) % fixedSetSizePortions.size();
-            currentPortion = fixedSetSizePortions[currentPortionIndex];
-            stagnationCounter = 0;
+        if (pipelinedIterations) {
+            preparedIterations->close();
+            preparingThread.join();
         }
+
+        std::lock_guard<std::mutex> lock(solutionsMutex);
+        for (int i = 0; i < fixedSetSizePortions.size(); ++i) {
+            const PortionScheduler::PortionStatistics& statistics = portionScheduler.statistics()[i];
+            portionStatistics[i].numberOfIterations += statistics.numberOfIterations;
+            portionStatistics[i].numberOfNewBestSolutions += statistics.numberOfNewBestSolutions;
+            portionStatistics[i].totalImprovement += statistics.totalImprovement;
+            portionStatistics[i].seconds += statistics.seconds;
+        }
+    };
+
+    // Every thread runs a worker, which takes iterations until all are done or the time is up
+    ThreadPool::shared().parallelFor(numberOfThreads, worker, numberOfThreads);
+
+    if (checkpointWriter) {
+        checkpointWriter->submit(createCheckpoint());
+    }
+
+    lastPortionStatistics.clear();
+    for (int i = 0; i < fixedSetSizePortions.size(); ++i) {
+        lastPortionStatistics.push_back({fixedSetSizePortions[i], portionStatistics[i]});
+    }
+
+    reportProgress(true);
+
+    return bestSolutionWithValues->partition;
+}
+
+FixedSetSearch::PreparedIteration FixedSetSearch::prepareIteration(const ElitePool& solutionsWithValues,
+                                                                   const std::vector<int>& vertices,
+                                                                   const std::vector<std::vector<int>>& weights,
+                                                                   int m,
+                                                                   int n,
+                                                                   int k,
+                                                                   int portionIndex,
+                                                                   double portionOfFixedVertices,
+                                                                   int lengthOfRandomCandidateList,
+                                                                   const CancellationToken& cancellationToken) {
+    PreparedIteration preparedIteration;
+    preparedIteration.portionIndex = portionIndex;
+
+    int currentNumberOfSolutions = static_cast<int>(solutionsWithValues.size());
+    int m_restricted = std::min(m, currentNumberOfSolutions);  // to choose base solution from
+    int n_restricted = std::min(n, currentNumberOfSolutions);  // to choose k solutions from
+    int k_restricted = std::min(k, currentNumberOfSolutions);  // to choose solutions for building the fixed partial solution
+
+    // shuffle the indices of the n best solutions to get k random solutions for the fixed partial solution
+    std::vector<int> indicesForFixedSet(n_restricted);
+    std::iota(indicesForFixedSet.begin(), indicesForFixedSet.end(), 0);
+    shuffleVector(indicesForFixedSet);
+
+    std::vector<SharedSolution> solutionsForFixedSet;
+    for (int i = 0; i < k_restricted; ++i) {
+        solutionsForFixedSet.push_back(solutionsWithValues[indicesForFixedSet[i]]);
+    }
+
+    // Select the base solution out of the m best solutions
+    int index = RandomNumberGenerator::getRandomNumberBelow(m_restricted);
+    preparedIteration.baseSolution = solutionsWithValues[index];
+
+    // Find fixed partial solution
+    preparedIteration.fixedPartialSolution = findFixedPartialSolution(preparedIteration.baseSolution->partition, solutionsForFixedSet, portionOfFixedVertices);
+
+    if (contractFixedCliques) {
+        preparedIteration.contractedProblem = GraphContraction::contract(preparedIteration.fixedPartialSolution, weights);
+        preparedIteration.fixedPartialSolution = preparedIteration.contractedProblem->initialPartition;
+    }
+
+    const std::vector<int>& verticesOfProblem = contractFixedCliques ? preparedIteration.contractedProblem->vertices : vertices;
+    const std::vector<std::vector<int>>& weightsOfProblem = contractFixedCliques ? preparedIteration.contractedProblem->weights : weights;
+
+    // Perform GRASP on the fixed partial solution
+    preparedIteration.partition = GreedyAdding::run(verticesOfProblem, weightsOfProblem, preparedIteration.fixedPartialSolution, lengthOfRandomCandidateList, cancellationToken);
+    preparedIteration.partition = GreedyMoving::run(verticesOfProblem, weightsOfProblem, preparedIteration.partition, cancellationToken);
+
+    return preparedIteration;
+}
+
+std::pair<Partition, int> FixedSetSearch::finishIteration(const PreparedIteration& preparedIteration,
+                                                          const std::vector<int>& vertices,
+                                                          const std::vector<std::vector<int>>& weights,
+                                                          double initialTemperature,
+                                                          double batchSizeScaleFactor,
+                                                          double cooldownFactor,
+                                                          double minimalTransitionRatio,
+                                                          const CancellationToken& cancellationToken) {
+    const std::optional<GraphContraction::ContractedProblem>& contractedProblem = preparedIteration.contractedProblem;
+    const std::vector<int>& verticesOfProblem = contractedProblem ? contractedProblem->vertices : vertices;
+    const std::vector<std::vector<int>>& weightsOfProblem = contractedProblem ? contractedProblem->weights : weights;
+
+    Partition partition;
+    int value;
+    if (annealOnlyFreeVertices) {
+        std::vector<int> freeVertices;
+        for (int vertex : verticesOfProblem) {
+            if (!preparedIteration.fixedPartialSolution.isAssigned(vertex)) {
+                freeVertices.push_back(vertex);
+            }
+        }
+
+        std::tie(partition, value) = SimulatedAnnealing::runOnActiveVertices(preparedIteration.partition, freeVertices, verticesOfProblem, weightsOfProblem, initialTemperature,
+                                                                             batchSizeScaleFactor, cooldownFactor, minimalTransitionRatio, std::nullopt, relaxationTemperatureFactor, cancellationToken);
+    } else {
+        std::tie(partition, value) = SimulatedAnnealing::run(preparedIteration.partition, verticesOfProblem, weightsOfProblem, initialTemperature,
+                                                             batchSizeScaleFactor, cooldownFactor, minimalTransitionRatio, std::nullopt, cancellationToken);
+    }
+
+    if (contractedProblem) {
+        partition = GraphContraction::expand(partition, *contractedProblem);
+        value += contractedProblem->valueOfContractedCliques;
     }
 
-    return bestSolutionWithValues.partition;
+    return {std::move(partition), value};
 }
 
-void FixedSetSearch::shuffleVector(std::vector<SolutionWithValueAndIndexLookup>& vec) {
-    static std::random_device rd;
-    static std::mt19937 g(rd());
-    std::shuffle(vec.begin(), vec.end(), g);
+bool FixedSetSearch::isOutdated(const PreparedIteration& preparedIteration,
+                                const ElitePool& solutionsWithValues) {
+    return !solutionsWithValues.holds(preparedIteration.baseSolution);
+}
+
+void FixedSetSearch::shuffleVector(std::vector<int>& vec) {
+    // Fisher-Yates shuffle with the generator of the calling thread
+    for (int i = static_cast<int>(vec.size()) - 1; i > 0; --i) {
+        std::swap(vec[i], vec[RandomNumberGenerator::getRandomNumberBelow(i + 1)]);
+    }
 }
 
 std::vector<double> FixedSetSearch::initializeFixedSetSizePortions(int numberOfVertices) {
@@ -168,56 +489,73 @@ std::vector<double> FixedSetSearch::initializeFixedSetSizePortions(int numberOfV
     return fixedSetSizePortions;
 }
 
-std::vector<std::list<int>> FixedSetSearch::findFixedPartialSolution(const std::vector<std::list<int>>& baseSolution,
-                                                                     const std::vector<SolutionWithValueAndIndexLookup>& solutionsForFixedSet,
-                                                                     double portionOfFixedVertices) {
+Partition FixedSetSearch::findFixedPartialSolution(const Partition& baseSolution,
+                                                   const std::vector<SharedSolution>& solutionsForFixedSet,
+                                                   double portionOfFixedVertices) {
+    int numberOfVertices = baseSolution.numberOfVertices();
     std::vector<std::pair<int, double>> vertexSimilarityScores;
 
+    // For each clique of the base solution and each solution to compare with, count how many vertices of the clique
+    // are in each clique of the compared solution. Then the number of vertices of the base clique that share the clique
+    // with a vertex in the compared solution can be looked up for all vertices of the base clique at once.
+    std::vector<int> numberOfVerticesInCompareClique(numberOfVertices, 0);
+    std::vector<int> numberOfSameVertices;
+
     // Compute similarity scores
-    for (const auto& cliqueOfBaseSolution : baseSolution) {
-        for (int vertex : cliqueOfBaseSolution) {
-            double similarityScoreForVertex = 0;
-            for (const auto& solution : solutionsForFixedSet) {
-                int cliqueIndexInCompareSolution = solution.cliqueIndexForVertex[vertex];
-                int numberOfSameVertices = 0;
-
-                for (int v : cliqueOfBaseSolution) {
-                    if (solution.cliqueIndexForVertex[v] == cliqueIndexInCompareSolution) {
-                        ++numberOfSameVertices;
-                    }
-                }
+    for (int baseCliqueIndex = 0; baseCliqueIndex < baseSolution.numberOfCliques(); ++baseCliqueIndex) {
+        Partition::Clique cliqueOfBaseSolution = baseSolution.clique(baseCliqueIndex);
+        if (cliqueOfBaseSolution.empty()) {
+            continue;
+        }
+
+        numberOfSameVertices.assign(cliqueOfBaseSolution.size(), 0);
 
-                similarityScoreForVertex += static_cast<double>(numberOfSameVertices);
+        for (const auto& solution : solutionsForFixedSet) {
+            for (int v : cliqueOfBaseSolution) {
+                numberOfVerticesInCompareClique[solution->cliqueIndexForVertex(v)]++;
             }
-            similarityScoreForVertex /= static_cast<double>(cliqueOfBaseSolution.size());
+
+            int i = 0;
+            for (int vertex : cliqueOfBaseSolution) {
+                numberOfSameVertices[i++] += numberOfVerticesInCompareClique[solution->cliqueIndexForVertex(vertex)];
+            }
+
+            // reset only the counters that were used
+            for (int v : cliqueOfBaseSolution) {
+                numberOfVerticesInCompareClique[solution->cliqueIndexForVertex(v)] = 0;
+            }
+        }
+
+        int i = 0;
+        for (int vertex : cliqueOfBaseSolution) {
+            double similarityScoreForVertex = static_cast<double>(numberOfSameVertices[i++]) / static_cast<double>(cliqueOfBaseSolution.size());
             vertexSimilarityScores.push_back({vertex, similarityScoreForVertex});
         }
     }
 
-    // Sort vertices by similarity score
-    std::sort(vertexSimilarityScores.begin(), vertexSimilarityScores.end(),
-              [](const std::pair<int, double>& a, const std::pair<int, double>& b) {
-                  return a.second > b.second;
-              });
-
-    // Select the top portion of fixed vertices
+    // Select the top portion of fixed vertices, only these have to be brought to the front
     int sizeOfFixedPartialSolution = static_cast<int>(round(portionOfFixedVertices * vertexSimilarityScores.size()));
-    std::vector<int> verticesToKeep;
+    if (sizeOfFixedPartialSolution > 0 && sizeOfFixedPartialSolution < vertexSimilarityScores.size()) {
+        std::nth_element(vertexSimilarityScores.begin(),
+                         vertexSimilarityScores.begin() + sizeOfFixedPartialSolution - 1,
+                         vertexSimilarityScores.end(),
+                         [](const std::pair<int, double>& a, const std::pair<int, double>& b) {
+                             return a.second > b.second;
+                         });
+    }
+
+    std::vector<bool> isVertexToKeep(numberOfVertices, false);
     for (int i = 0; i < sizeOfFixedPartialSolution; ++i) {
-        verticesToKeep.push_back(vertexSimilarityScores[i].first);
+        isVertexToKeep[vertexSimilarityScores[i].first] = true;
     }
 
-    // Create the fixed partial solution
-    std::vector<std::list<int>> fixedPartialSolution;
-    for (const auto& clique : baseSolution) {
-        std::list<int> newClique;
-        for (int vertex : clique) {
-            if (std::find(verticesToKeep.begin(), verticesToKeep.end(), vertex) != verticesToKeep.end()) {
-                newClique.push_back(vertex);
-            }
+    // Create the fixed partial solution, all vertices that are not kept are left unassigned
+    std::vector<int> cliqueIndexForVertex(numberOfVertices, -1);
+    for (int vertex = 0; vertex < numberOfVertices; ++vertex) {
+        if (isVertexToKeep[vertex]) {
+            cliqueIndexForVertex[vertex] = baseSolution.cliqueIndexForVertex(vertex);
         }
-        fixedPartialSolution.push_back(newClique);
     }
 
-    return fixedPartialSolution;
+    return Partition(std::move(cliqueIndexForVertex));
 }
@@ -1,19 +1,25 @@
 #include "GRASP.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <tuple>
 #include <iostream>
-#include <list>
 #include <vector>
 
 #include "GreedyAdding.h"
 #include "GreedyMoving.h"
+#include "RandomNumberGenerator.h"
 #include "SimulatedAnnealing.h"
 #include "SolutionClass.h"
+#include "SolutionHashSet.h"
+#include "ThreadPool.h"
 #include "utils.h"
 
 std::pair<
-    SolutionWithValueAndIndexLookup,
-    std::vector<SolutionWithValueAndIndexLookup>>
+    SharedSolution,
+    std::vector<SharedSolution>>
 GRASP::run(int numberOfDesiredSolutions,
            const std::vector<int>& vertices,
            const std::vector<std::vector<int>>& weights,
@@ -21,27 +27,40 @@ GRASP::run(int numberOfDesiredSolutions,
            double initialTemperature,
            double batchSizeScaleFactor,
            double cooldownFactor,
-           double minimalTransitionRatio) {
-    std::vector<SolutionWithValueAndIndexLookup> solutionsWithValues;
+           double minimalTransitionRatio,
+           int numberOfThreads,
+           const CancellationToken& cancellationToken) {
+    // Every solution gets its own stream of random numbers, so that the result doesn't depend on the number of threads
+    uint64_t seed = RandomNumberGenerator::getRandomSeed();
+    std::vector<SharedSolution> newSolutions(numberOfDesiredSolutions);
 
-    for (int i = 0; i < numberOfDesiredSolutions; ++i) {
-        std::vector<std::list<int>> partition;
-        int value;
-        double duration;
+    ThreadPool::shared().parallelFor(
+        numberOfDesiredSolutions,
+        [&](int i) {
+            RandomNumberGenerator::ScopedSeed scopedSeed(seed + i);
 
-        partition = GreedyAdding::runForEmptyPartition(vertices, weights, lengthOfRandomCandidateList);
-        partition = GreedyMoving::run(vertices, weights, partition);
-        partition = SimulatedAnnealing::run(partition, vertices, weights, initialTemperature, batchSizeScaleFactor, cooldownFactor, minimalTransitionRatio);
+            Partition partition;
+            int value;
+            partition = GreedyAdding::runForEmptyPartition(vertices, weights, lengthOfRandomCandidateList, cancellationToken);
+            partition = GreedyMoving::run(vertices, weights, partition, cancellationToken);
+            std::tie(partition, value) = SimulatedAnnealing::run(partition, vertices, weights, initialTemperature, batchSizeScaleFactor, cooldownFactor, minimalTransitionRatio, std::nullopt, cancellationToken);
 
-        auto newSolution = SolutionWithValueAndIndexLookup(partition, weights);
+            newSolutions[i] = std::make_shared<const SolutionWithValueAndIndexLookup>(std::move(partition), value, weights);
+        },
+        numberOfThreads);
 
+    std::vector<SharedSolution> solutionsWithValues;
+    SolutionHashSet uniqueSolutions;
+
+    for (auto& newSolution : newSolutions) {
         // add the solution, if it is not already in the solutionsWithValues vector
-        if (std::find(solutionsWithValues.begin(), solutionsWithValues.end(), newSolution) == solutionsWithValues.end()) {
-            solutionsWithValues.push_back(newSolution);
+        if (uniqueSolutions.insert(newSolution)) {
+            solutionsWithValues.push_back(std::move(newSolution));
         }
     }
 
-    SolutionWithValueAndIndexLookup bestSolutionWithValue = *std::max_element(solutionsWithValues.begin(), solutionsWithValues.end());
+    SharedSolution bestSolutionWithValue = *std::max_element(solutionsWithValues.begin(), solutionsWithValues.end(),
+                                                             [](const SharedSolution& a, const SharedSolution& b) { return *a < *b; });
 
     return {bestSolutionWithValue, solutionsWithValues};
 }
@@ -0,0 +1,74 @@
+#include "GraphContraction.h"
+
+#include <numeric>
+#include <vector>
+
+GraphContraction::ContractedProblem GraphContraction::contract(const Partition& fixedPartialSolution,
+                                                               const std::vector<std::vector<int>>& weights) {
+    ContractedProblem contractedProblem;
+    int numberOfVertices = fixedPartialSolution.numberOfVertices();
+
+    // The non-empty fixed cliques become the first contracted vertices, followed by the free vertices
+    std::vector<int>& contractedVertexForVertex = contractedProblem.contractedVertexForVertex;
+    contractedVertexForVertex.assign(numberOfVertices, -1);
+
+    int numberOfContractedVertices = 0;
+    for (int cliqueIndex = 0; cliqueIndex < fixedPartialSolution.numberOfCliques(); ++cliqueIndex) {
+        Partition::Clique clique = fixedPartialSolution.clique(cliqueIndex);
+        if (clique.empty()) {
+            continue;
+        }
+
+        for (int vertex : clique) {
+            contractedVertexForVertex[vertex] = numberOfContractedVertices;
+        }
+        numberOfContractedVertices++;
+    }
+
+    int numberOfContractedCliques = numberOfContractedVertices;
+    for (int vertex = 0; vertex < numberOfVertices; ++vertex) {
+        if (!fixedPartialSolution.isAssigned(vertex)) {
+            contractedVertexForVertex[vertex] = numberOfContractedVertices++;
+        }
+    }
+
+    contractedProblem.vertices.resize(numberOfContractedVertices);
+    std::iota(contractedProblem.vertices.begin(), contractedProblem.vertices.end(), 0);
+
+    // Sum up the weights between the contracted vertices in a single pass over the weight matrix
+    std::vector<std::vector<int>>& contractedWeights = contractedProblem.weights;
+    contractedWeights.assign(numberOfContractedVertices, std::vector<int>(numberOfContractedVertices, 0));
+
+    for (int vertex = 0; vertex < numberOfVertices; ++vertex) {
+        std::vector<int>& contractedWeightsOfVertex = contractedWeights[contractedVertexForVertex[vertex]];
+        const std::vector<int>& weightsOfVertex = weights[vertex];
+
+        for (int otherVertex = 0; otherVertex < numberOfVertices; ++otherVertex) {
+            contractedWeightsOfVertex[contractedVertexForVertex[otherVertex]] += weightsOfVertex[otherVertex];
+        }
+    }
+
+    // The diagonal holds every edge inside a contracted clique twice
+    for (int contractedVertex = 0; contractedVertex < numberOfContractedVertices; ++contractedVertex) {
+        contractedProblem.valueOfContractedCliques += contractedWeights[contractedVertex][contractedVertex] / 2;
+        contractedWeights[contractedVertex][contractedVertex] = 0;
+    }
+
+    std::vector<int> cliqueIndexForContractedVertex(numberOfContractedVertices, -1);
+    std::iota(cliqueIndexForContractedVertex.begin(), cliqueIndexForContractedVertex.begin() + numberOfContractedCliques, 0);
+    contractedProblem.initialPartition = Partition(std::move(cliqueIndexForContractedVertex));
+
+    return contractedProblem;
+}
+
+Partition GraphContraction::expand(const Partition& contractedPartition,
+                                   const ContractedProblem& contractedProblem) {
+    const std::vector<int>& contractedVertexForVertex = contractedProblem.contractedVertexForVertex;
+
+    std::vector<int> cliqueIndexForVertex(contractedVertexForVertex.size());
+    for (int vertex = 0; vertex < contractedVertexForVertex.size(); ++vertex) {
+        cliqueIndexForVertex[vertex] = contractedPartition.cliqueIndexForVertex(contractedVertexForVertex[vertex]);
+    }
+
+    return Partition(std::move(cliqueIndexForVertex));
+}
@@ -3,96 +3,144 @@
 #include <algorithm>
 #include <iostream>
 #include <limits>
-#include <list>
 #include <random>
 #include <tuple>
 #include <vector>
 
 #include "RandomNumberGenerator.h"
+#include "RestrictedCandidateList.h"
 
 // Static function to find the solution for an empty partition
-std::vector<std::list<int>> GreedyAdding::runForEmptyPartition(const std::vector<int>& vertices,
-                                                               const std::vector<std::vector<int>>& weights,
-                                                               int lengthOfRandomCandidateList = 2) {
-    std::vector<std::list<int>> initialPartition(vertices.size());
-    return run(vertices, weights, initialPartition, lengthOfRandomCandidateList);
+Partition GreedyAdding::runForEmptyPartition(const std::vector<int>& vertices,
+                                             const std::vector<std::vector<int>>& weights,
+                                             int lengthOfRandomCandidateList,
+                                             const CancellationToken& cancellationToken) {
+    Partition initialPartition(vertices.size());
+    return run(vertices, weights, initialPartition, lengthOfRandomCandidateList, cancellationToken);
 }
 
 // Static function to find the solution
-std::vector<std::list<int>> GreedyAdding::run(const std::vector<int>& vertices,
-                                              const std::vector<std::vector<int>>& weights,
-                                              std::vector<std::list<int>>& initialPartition,
-                                              int lengthOfRandomCandidateList = 2) {
-    std::vector<int> verticesInInitialPartition;
-    for (const auto& clique : initialPartition) {
-        for (int vertex : clique) {
-            verticesInInitialPartition.push_back(vertex);
-        }
-    }
-
+Partition GreedyAdding::run(const std::vector<int>& vertices,
+                            const std::vector<std::vector<int>>& weights,
+                            const Partition& initialPartition,
+                            int lengthOfRandomCandidateList,
+                            const CancellationToken& cancellationToken) {
     std::vector<int> candidateVertices;
     for (int v : vertices) {
-        if (std::find(verticesInInitialPartition.begin(), verticesInInitialPartition.end(), v) == verticesInInitialPartition.end()) {
+        if (!initialPartition.isAssigned(v)) {
             candidateVertices.push_back(v);
         }
     }
 
-    std::vector<std::list<int>> currentPartition = initialPartition;
-    std::vector<std::vector<int>> benefitOfAddingVertexToClique = initializeBenefitOfAddingVertexToClique(candidateVertices, currentPartition, weights);
+    std::vector<int> cliqueIndexForVertex = initialPartition.cliqueIndexForVertexLookup();
+    std::vector<int> numberOfVerticesInCliques(initialPartition.numberOfCliques());
+    for (int i = 0; i < initialPartition.numberOfCliques(); ++i) {
+        numberOfVerticesInCliques[i] = initialPartition.cliqueSize(i);
+    }
+
+    // make sure that there is an empty clique to open new cliques with
+    if (std::find(numberOfVerticesInCliques.begin(), numberOfVerticesInCliques.end(), 0) == numberOfVerticesInCliques.end()) {
+        numberOfVerticesInCliques.push_back(0);
+    }
+
+    std::vector<std::vector<int>> benefitOfAddingVertexToClique = initializeBenefitOfAddingVertexToClique(candidateVertices, initialPartition, numberOfVerticesInCliques.size(), weights);
+
+    // Only the non-empty cliques and the first empty clique are considered for adding moves,
+    // as all other empty cliques would lead to the same partition
+    int firstEmptyCliqueIndex = std::find(numberOfVerticesInCliques.begin(), numberOfVerticesInCliques.end(), 0) - numberOfVerticesInCliques.begin();
+    std::vector<int> activeCliques;
+    for (int i = 0; i < numberOfVerticesInCliques.size(); ++i) {
+        if (numberOfVerticesInCliques[i] > 0 || i == firstEmptyCliqueIndex) {
+            activeCliques.push_back(i);
+        }
+    }
+
+    RestrictedCandidateList restrictedCandidateList(benefitOfAddingVertexToClique, lengthOfRandomCandidateList, activeCliques);
 
     size_t required_iterations = candidateVertices.size();
     for (size_t i = 0; i < required_iterations; ++i) {
-        addingVertexToPartitionStep(candidateVertices, benefitOfAddingVertexToClique, currentPartition, weights, lengthOfRandomCandidateList);
-    }
+        if (cancellationToken.isCancelled()) {
+            // Every remaining vertex gets a new clique, which keeps the partition valid
+            int nextEmptyCliqueIndex = numberOfVerticesInCliques.size();
+            for (int vertex : candidateVertices) {
+                cliqueIndexForVertex[vertex] = nextEmptyCliqueIndex++;
+            }
+            break;
+        }
 
-    currentPartition.resize(vertices.size());
+        addingVertexToPartitionStep(candidateVertices, benefitOfAddingVertexToClique, cliqueIndexForVertex, numberOfVerticesInCliques, weights, restrictedCandidateList, firstEmptyCliqueIndex);
+    }
 
-    return currentPartition;
+    return Partition(std::move(cliqueIndexForVertex));
 }
 
 // Static function to handle adding vertex to partition
 void GreedyAdding::addingVertexToPartitionStep(std::vector<int>& candidateVertices,
                                                std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
-                                               std::vector<std::list<int>>& currentPartition,
+                                               std::vector<int>& cliqueIndexForVertex,
+                                               std::vector<int>& numberOfVerticesInCliques,
                                                const std::vector<std::vector<int>>& weights,
-                                               int lengthOfRandomCandidateList) {
+                                               RestrictedCandidateList& restrictedCandidateList,
+                                               int& firstEmptyCliqueIndex) {
     int vertexIndex, cliqueIndex;
 
-    int firstEmptyCliqueIndex = std::find_if(currentPartition.begin(),
-                                             currentPartition.end(),
-                                             [](const std::list<int>& clique) { return clique.empty(); }) -
-                                currentPartition.begin();
-    std::tie(vertexIndex, cliqueIndex) = getIndicesOfRandomAddingMoveFromBestOptions(benefitOfAddingVertexToClique, lengthOfRandomCandidateList, candidateVertices, firstEmptyCliqueIndex);
-    currentPartition[cliqueIndex].push_back(candidateVertices[vertexIndex]);
-    updateBenefitOfAddingVertexToClique(benefitOfAddingVertexToClique, candidateVertices, currentPartition, weights, vertexIndex, cliqueIndex);
-    candidateVertices.erase(candidateVertices.begin() + vertexIndex);
+    std::tie(vertexIndex, cliqueIndex) = getIndicesOfRandomAddingMoveFromBestOptions(benefitOfAddingVertexToClique, restrictedCandidateList, candidateVertices);
+    cliqueIndexForVertex[candidateVertices[vertexIndex]] = cliqueIndex;
+    numberOfVerticesInCliques[cliqueIndex]++;
+    updateBenefitOfAddingVertexToClique(benefitOfAddingVertexToClique, candidateVertices, weights, vertexIndex, cliqueIndex, restrictedCandidateList);
+
+    // remove the vertex from the candidates by moving the last candidate into its place, like it was done for the benefit table
+    candidateVertices[vertexIndex] = candidateVertices.back();
+    candidateVertices.pop_back();
+
+    if (cliqueIndex != firstEmptyCliqueIndex) {
+        return;
+    }
+
+    // The first empty clique was used, so the next empty clique has to be considered from now on
+    firstEmptyCliqueIndex = std::find(numberOfVerticesInCliques.begin() + cliqueIndex + 1, numberOfVerticesInCliques.end(), 0) - numberOfVerticesInCliques.begin();
+
+    if (firstEmptyCliqueIndex == numberOfVerticesInCliques.size()) {
+        numberOfVerticesInCliques.push_back(0);
+        for (auto& row : benefitOfAddingVertexToClique) {
+            row.push_back(0);
+        }
+    }
+
+    restrictedCandidateList.activateClique(benefitOfAddingVertexToClique, firstEmptyCliqueIndex);
 }
 
 void GreedyAdding::updateBenefitOfAddingVertexToClique(std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
                                                        const std::vector<int>& candidateVertices,
-                                                       const std::vector<std::list<int>>& currentPartition,
                                                        const std::vector<std::vector<int>>& weights,
                                                        int vertexIndex,
-                                                       int cliqueIndex) {
+                                                       int cliqueIndex,
+                                                       RestrictedCandidateList& restrictedCandidateList) {
     int movedVertex = candidateVertices[vertexIndex];
 
     for (size_t i = 0; i < candidateVertices.size(); ++i) {
         benefitOfAddingVertexToClique[i][cliqueIndex] += weights[candidateVertices[i]][movedVertex];
     }
 
-    benefitOfAddingVertexToClique.erase(benefitOfAddingVertexToClique.begin() + vertexIndex);
+    // Only the column of the clique changed, so only this column has to be checked for new best moves
+    restrictedCandidateList.updateClique(benefitOfAddingVertexToClique, cliqueIndex);
+
+    // remove the row of the added vertex by moving the last row into its place
+    std::swap(benefitOfAddingVertexToClique[vertexIndex], benefitOfAddingVertexToClique.back());
+    benefitOfAddingVertexToClique.pop_back();
+    restrictedCandidateList.removeVertex(vertexIndex);
 }
 
 // Static function to initialize benefit of adding vertex to clique
 std::vector<std::vector<int>> GreedyAdding::initializeBenefitOfAddingVertexToClique(const std::vector<int>& candidateVertices,
-                                                                                    const std::vector<std::list<int>>& currentPartition,
+                                                                                    const Partition& currentPartition,
+                                                                                    int numberOfCliques,
                                                                                     const std::vector<std::vector<int>>& weights) {
-    std::vector<std::vector<int>> benefit(candidateVertices.size(), std::vector<int>(currentPartition.size(), 0));
-    // Initialization logic for benefit can be added here based on weights
+    std::vector<std::vector<int>> benefit(candidateVertices.size(), std::vector<int>(numberOfCliques, 0));
 
     for (size_t i = 0; i < candidateVertices.size(); ++i) {
-        for (size_t j = 0; j < currentPartition.size(); ++j) {
-            for (int vertex : currentPartition[j]) {
+        for (size_t j = 0; j < currentPartition.numberOfCliques(); ++j) {
+            for (int vertex : currentPartition.clique(j)) {
                 benefit[i][j] += weights[candidateVertices[i]][vertex];
             }
         }
@@ -102,55 +150,13 @@ std::vector<std::vector<int>> GreedyAdding::initializeBenefitOfAddingVertexToCli
 }
 
 std::pair<int, int> GreedyAdding::getIndicesOfRandomAddingMoveFromBestOptions(const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
-                                                                              int lengthOfRandomCandidateList,
-                                                                              const std::vector<int>& candidateVertices,
-                                                                              int firstEmptyCliqueIndex) {
+                                                                              RestrictedCandidateList& restrictedCandidateList,
+                                                                              const std::vector<int>& candidateVertices) {
     // Tuple for
     // 1. vertexIndex
     // 2. cliqueIndex
     // 3. benefit
-    std::vector<std::tuple<int, int, int>> randomCandidateList;
-
-    // Fill the Random Candidate List with the first i additions of the first vertex
-    // Assuming that the random candiate list is shorter than the number of vertices.
-    int firstVertex = 0;
-    for (int i = 0; i < lengthOfRandomCandidateList; i++) {
-        randomCandidateList.push_back({firstVertex, i, benefitOfAddingVertexToClique[firstVertex][i]});
-        continue;
-    }
-
-    int randomCandidateListMinumum = std::get<2>(*std::min_element(randomCandidateList.begin(), randomCandidateList.end(),
-                                                                   [](const std::tuple<int, int, int>& a, const std::tuple<int, int, int>& b) {
-                                                                       return std::get<2>(a) < std::get<2>(b);
-                                                                   }));
-
-    for (const auto& row : benefitOfAddingVertexToClique) {
-        // the first empty clique should mark the end of all existing cliques
-        // and we don't need to look further, as only other empty cliques should follow the first empty one
-        // TODO: This could be handled by looking at the first non-empty clique from the back, to be more stable
-        for (int i = 0; i <= firstEmptyCliqueIndex; ++i) {
-            int current_benefit = row[i];
-
-            // add to randomCandidateList if the current_benefit is better than the miniumum of the randomCandidateList
-            if (current_benefit > randomCandidateListMinumum) {
-                auto vertexIndex = &row - &benefitOfAddingVertexToClique[0];
-                randomCandidateList.push_back({vertexIndex, i, current_benefit});
-
-                // remove the minimum element from the list if it is too long
-                auto minElement = std::min_element(randomCandidateList.begin(), randomCandidateList.end(),
-                                                   [](const std::tuple<int, int, int>& a, const std::tuple<int, int, int>& b) {
-                                                       return std::get<2>(a) < std::get<2>(b);
-                                                   });
-                randomCandidateList.erase(minElement);
-
-                // update the minimum of the randomCandidateList
-                randomCandidateListMinumum = std::get<2>(*std::min_element(randomCandidateList.begin(), randomCandidateList.end(),
-                                                                           [](const std::tuple<int, int, int>& a, const std::tuple<int, int, int>& b) {
-                                                                               return std::get<2>(a) < std::get<2>(b);
-                                                                           }));
-            }
-        }
-    }
+    const std::vector<std::tuple<int, int, int>>& randomCandidateList = restrictedCandidateList.getBestMoves();
 
     auto max_element_iter = std::max_element(randomCandidateList.begin(),
                                              randomCandidateList.end(),
@@ -170,4 +176,4 @@ std::pair<int, int> GreedyAdding::getIndicesOfRandomAddingMoveFromBestOptions(co
     auto randomCandidate = randomCandidateList[RandomNumberGenerator::getRandomNumberBelow(randomCandidateList.size())];
 
     return {std::get<0>(randomCandidate), std::get<1>(randomCandidate)};
-}
\ No newline at end of file
+}
@@ -2,41 +2,39 @@
 
 #include <algorithm>
 #include <limits>
-#include <list>
 #include <vector>
 
-#include "utils.h"
 
 // Function to initialize the moving table
 std::vector<std::vector<int>> GreedyMoving::initializeMovingTable(const std::vector<int>& vertices,
                                                                   const std::vector<std::vector<int>>& weights,
-                                                                  const std::vector<std::list<int>>& currentPartition) {
+                                                                  const Partition& currentPartition) {
     size_t numVertices = vertices.size();
 
-    int lastNonEmptyClique = std::distance(std::find_if(currentPartition.rbegin(),
-                                                        currentPartition.rend(),
-                                                        [](const std::list<int>& clique) { return not clique.empty(); }),
-                                           currentPartition.rend());
+    // One additional column for moving a vertex to a new clique
+    int numberOfCliques = currentPartition.numberOfCliques();
 
-    std::vector<std::vector<int>> benefitOfMovingVertex(numVertices, std::vector<int>(lastNonEmptyClique + 2, 0));
+    std::vector<std::vector<int>> benefitOfMovingVertex(numVertices, std::vector<int>(numberOfCliques + 1, 0));
 
     for (size_t vertexIndex = 0; vertexIndex < numVertices; ++vertexIndex) {
         int vertex = vertices[vertexIndex];
-        int originalCliqueIndex = utils::cliqueIndexForVertex(vertex, currentPartition);
+        int originalCliqueIndex = currentPartition.cliqueIndexForVertex(vertex);
 
         int decreaseInScore = 0;
-        for (int otherVertex : currentPartition[originalCliqueIndex]) {
+        for (int otherVertex : currentPartition.clique(originalCliqueIndex)) {
             if (vertex == otherVertex)
                 continue;
             decreaseInScore += weights[vertex][otherVertex];
         }
 
-        for (size_t cliqueIndexToMoveTo = 0; cliqueIndexToMoveTo < lastNonEmptyClique + 2; ++cliqueIndexToMoveTo) {
+        for (size_t cliqueIndexToMoveTo = 0; cliqueIndexToMoveTo < numberOfCliques + 1; ++cliqueIndexToMoveTo) {
             if (cliqueIndexToMoveTo == originalCliqueIndex)
                 continue;
 
-            for (int otherVertex : currentPartition[cliqueIndexToMoveTo]) {
-                benefitOfMovingVertex[vertexIndex][cliqueIndexToMoveTo] += weights[vertex][otherVertex];
+            if (cliqueIndexToMoveTo < numberOfCliques) {
+                for (int otherVertex : currentPartition.clique(cliqueIndexToMoveTo)) {
+                    benefitOfMovingVertex[vertexIndex][cliqueIndexToMoveTo] += weights[vertex][otherVertex];
+                }
             }
 
             benefitOfMovingVertex[vertexIndex][cliqueIndexToMoveTo] -= decreaseInScore;
@@ -68,17 +66,15 @@ std::pair<size_t, size_t> GreedyMoving::getBestMove(const std::vector<std::vecto
 }
 
 // Function to move a vertex from one clique to another
-void GreedyMoving::moveVertexFromTo(std::vector<std::list<int>>& currentPartition,
+void GreedyMoving::moveVertexFromTo(std::vector<int>& cliqueIndexForVertex,
                                     int vertex,
-                                    int oldCliqueIndex,
                                     int newCliqueIndex) {
-    currentPartition[oldCliqueIndex].remove(vertex);
-    currentPartition[newCliqueIndex].push_back(vertex);
+    cliqueIndexForVertex[vertex] = newCliqueIndex;
 }
 
 // Function to update the moving table after moving a vertex
 void GreedyMoving::updateMovingTable(const std::vector<std::vector<int>>& weights,
-                                     const std::vector<std::list<int>>& currentPartition,
+                                     const std::vector<int>& cliqueIndexForVertex,
                                      std::vector<std::vector<int>>& benefitOfMovingVertex,
                                      int vertexLastMoved,
                                      int oldCliqueIndex,
@@ -93,15 +89,17 @@ void GreedyMoving::updateMovingTable(const std::vector<std::vector<int>>& weight
         }
     }
 
-    for (int vertexPreviouslyConnected : currentPartition[oldCliqueIndex]) {
-        for (auto& benefit : benefitOfMovingVertex[vertexPreviouslyConnected]) {
-            benefit += weights[vertexPreviouslyConnected][vertexLastMoved];
-        }
-    }
-
-    for (int vertexNewlyConnected : currentPartition[newCliqueIndex]) {
-        for (auto& benefit : benefitOfMovingVertex[vertexNewlyConnected]) {
-            benefit -= weights[vertexNewlyConnected][vertexLastMoved];
+    for (int otherVertex = 0; otherVertex < numberOfVertices; ++otherVertex) {
+        if (cliqueIndexForVertex[otherVertex] == oldCliqueIndex) {
+            // the vertex was previously connected
+            for (auto& benefit : benefitOfMovingVertex[otherVertex]) {
+                benefit += weights[otherVertex][vertexLastMoved];
+            }
+        } else if (cliqueIndexForVertex[otherVertex] == newCliqueIndex) {
+            // the vertex is newly connected
+            for (auto& benefit : benefitOfMovingVertex[otherVertex]) {
+                benefit -= weights[otherVertex][vertexLastMoved];
+            }
         }
     }
 
@@ -119,25 +117,27 @@ void GreedyMoving::updateMovingTable(const std::vector<std::vector<int>>& weight
 }
 
 // Function to find the optimal partition
-std::vector<std::list<int>> GreedyMoving::run(const std::vector<int>& vertices,
-                                              const std::vector<std::vector<int>>& weights,
-                                              std::vector<std::list<int>> initialPartition) {
-    auto currentPartition = initialPartition;
-    auto benefitOfMovingVertex = initializeMovingTable(vertices, weights, currentPartition);
-
-    // Continue until no beneficial moves exist
-    while (std::any_of(benefitOfMovingVertex.begin(), benefitOfMovingVertex.end(),
+Partition GreedyMoving::run(const std::vector<int>& vertices,
+                            const std::vector<std::vector<int>>& weights,
+                            const Partition& initialPartition,
+                            const CancellationToken& cancellationToken) {
+    std::vector<int> cliqueIndexForVertex = initialPartition.cliqueIndexForVertexLookup();
+    auto benefitOfMovingVertex = initializeMovingTable(vertices, weights, initialPartition);
+
+    // Continue until no beneficial moves exist.
+    // Every move updates the whole table, so checking the token for each move costs next to nothing.
+    while (!cancellationToken.isCancelled() && std::any_of(benefitOfMovingVertex.begin(), benefitOfMovingVertex.end(),
                        [](const std::vector<int>& row) { return *std::max_element(row.begin(), row.end()) > 0; })) {
         auto [vertexIndex, newCliqueIndex] = getBestMove(benefitOfMovingVertex);
         int vertex = vertices[vertexIndex];
-        int oldCliqueIndex = utils::cliqueIndexForVertex(vertex, currentPartition);
+        int oldCliqueIndex = cliqueIndexForVertex[vertex];
 
         // Move the vertex and update the partition
-        moveVertexFromTo(currentPartition, vertex, oldCliqueIndex, newCliqueIndex);
+        moveVertexFromTo(cliqueIndexForVertex, vertex, newCliqueIndex);
 
         // Update the benefit of moving table
-        updateMovingTable(weights, currentPartition, benefitOfMovingVertex, vertexIndex, oldCliqueIndex, newCliqueIndex);
+        updateMovingTable(weights, cliqueIndexForVertex, benefitOfMovingVertex, vertexIndex, oldCliqueIndex, newCliqueIndex);
     }
 
-    return currentPartition;
+    return Partition(std::move(cliqueIndexForVertex));
 }
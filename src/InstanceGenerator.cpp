@@ -0,0 +1,195 @@
+#include "InstanceGenerator.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace {
+
+// Independent streams of random values, so that e.g. the weight of a pair doesn't depend on whether it has an edge
+enum Stream : uint64_t {
+    EDGE = 1,
+    WEIGHT = 2,
+    NOISE = 3,
+    CLUSTER = 4,
+    X_COORDINATE = 5,
+    Y_COORDINATE = 6
+};
+
+// splitmix64 finalizer, see https://prng.di.unimi.it/splitmix64.c
+uint64_t mix(uint64_t z) {
+    z += 0x9e3779b97f4a7c15;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+// Maps u in [0, 1) uniformly to the integers in [low, high]
+int uniformInteger(double u, int low, int high) {
+    if (high < low) {
+        return 0;
+    }
+    return std::min(high, low + static_cast<int>(u * (static_cast<int64_t>(high) - low + 1)));
+}
+
+}  // namespace
+
+InstanceGenerator::InstanceGenerator(Options options) : options(options) {
+    int numberOfVertices = options.numberOfVertices;
+
+    edgeProbability = options.density;
+    if (options.variant == SPARSE) {
+        edgeProbability = numberOfVertices > 1 ? options.averageDegree / (numberOfVertices - 1) : 0.0;
+    }
+
+    if (options.variant == PLANTED_PARTITION) {
+        int numberOfClusters = std::max(1, options.numberOfClusters);
+        clusterForVertex.resize(numberOfVertices);
+        for (int vertex = 0; vertex < numberOfVertices; ++vertex) {
+            clusterForVertex[vertex] = std::min(numberOfClusters - 1, static_cast<int>(randomValue(CLUSTER, vertex) * numberOfClusters));
+        }
+    }
+
+    if (options.variant == GEOMETRIC) {
+        pointForVertex.resize(numberOfVertices);
+        for (int vertex = 0; vertex < numberOfVertices; ++vertex) {
+            pointForVertex[vertex] = {randomValue(X_COORDINATE, vertex), randomValue(Y_COORDINATE, vertex)};
+        }
+    }
+}
+
+int InstanceGenerator::numberOfVertices() const {
+    return options.numberOfVertices;
+}
+
+int InstanceGenerator::weight(int vertex1, int vertex2) const {
+    if (vertex1 == vertex2) {
+        return 0;
+    }
+
+    // The same key for both orders keeps the weights symmetric
+    uint64_t key = static_cast<uint64_t>(std::min(vertex1, vertex2)) * options.numberOfVertices + std::max(vertex1, vertex2);
+    if (randomValue(EDGE, key) >= edgeProbability) {
+        return 0;
+    }
+
+    double u = randomValue(WEIGHT, key);
+    switch (options.variant) {
+        case PLANTED_PARTITION: {
+            bool sameCluster = clusterForVertex[vertex1] == clusterForVertex[vertex2];
+            if (randomValue(NOISE, key) < options.noise) {
+                sameCluster = !sameCluster;
+            }
+            return sameCluster ? uniformInteger(u, 1, options.maximalWeight) : uniformInteger(u, options.minimalWeight, -1);
+        }
+        case GEOMETRIC: {
+            auto [x1, y1] = pointForVertex[vertex1];
+            auto [x2, y2] = pointForVertex[vertex2];
+            double distance = std::hypot(x1 - x2, y1 - y2);
+            if (distance < options.radius) {
+                return static_cast<int>(std::lround(options.maximalWeight * (1 - distance / options.radius)));
+            }
+            return static_cast<int>(std::lround(options.minimalWeight * (distance - options.radius) / (std::sqrt(2.0) - options.radius)));
+        }
+        default:
+            return uniformInteger(u, options.minimalWeight, options.maximalWeight);
+    }
+}
+
+int InstanceGenerator::plantedCliqueIndexForVertex(int vertex) const {
+    return clusterForVertex.empty() ? -1 : clusterForVertex[vertex];
+}
+
+std::pair<std::vector<int>, std::vector<std::vector<int>>> InstanceGenerator::generate() const {
+    int numberOfVertices = options.numberOfVertices;
+
+    std::vector<int> vertices(numberOfVertices);
+    for (int i = 0; i < numberOfVertices; ++i) {
+        vertices[i] = i;
+    }
+
+    // Every weight only depends on its pair, so the rows can be filled in parallel
+    std::vector<std::vector<int>> weights(numberOfVertices);
+    ThreadPool::shared().parallelFor(
+        numberOfVertices,
+        [&](int i) {
+            weights[i].resize(numberOfVertices);
+            for (int j = 0; j < numberOfVertices; ++j) {
+                weights[i][j] = weight(i, j);
+            }
+        },
+        ThreadPool::defaultNumberOfThreads());
+
+    return {vertices, weights};
+}
+
+bool InstanceGenerator::writeToFile(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open " << filename << std::endl;
+        return false;
+    }
+
+    int numberOfVertices = options.numberOfVertices;
+    file << numberOfVertices << "\n";
+
+    // A batch of rows is formatted in parallel and then written in order, so only the batch is in memory
+    const int rowsPerBatch = 64;
+    std::vector<std::string> rows(rowsPerBatch);
+    for (int firstRow = 0; firstRow < numberOfVertices; firstRow += rowsPerBatch) {
+        int numberOfRows = std::min(rowsPerBatch, numberOfVertices - firstRow);
+        ThreadPool::shared().parallelFor(
+            numberOfRows,
+            [&](int rowOffset) {
+                int i = firstRow + rowOffset;
+                std::string& row = rows[rowOffset];
+                row.clear();
+
+                char buffer[16];
+                for (int j = i + 1; j < numberOfVertices; ++j) {
+                    char* end = std::to_chars(buffer, buffer + sizeof(buffer), weight(i, j)).ptr;
+                    row.append(buffer, end);
+                    row.push_back(j + 1 < numberOfVertices ? ' ' : '\n');
+                }
+            },
+            ThreadPool::defaultNumberOfThreads());
+
+        for (int rowOffset = 0; rowOffset < numberOfRows; ++rowOffset) {
+            file << rows[rowOffset];
+        }
+    }
+
+    if (!file) {
+        std::cerr << "Error: Could not write " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InstanceGenerator::parseVariant(const std::string& name, Variant& variant) {
+    if (name == "uniform") {
+        variant = UNIFORM;
+    } else if (name == "planted") {
+        variant = PLANTED_PARTITION;
+    } else if (name == "geometric") {
+        variant = GEOMETRIC;
+    } else if (name == "sparse") {
+        variant = SPARSE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+double InstanceGenerator::randomValue(uint64_t stream, uint64_t key) const {
+    uint64_t z = mix(mix(options.seed ^ (stream * 0xd1b54a32d192ed03)) ^ key);
+    return (z >> 11) * 0x1.0p-53;
+}
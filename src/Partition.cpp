@@ -0,0 +1,129 @@
+#include "Partition.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+Partition::Partition(int numberOfVertices)
+    : cliqueIndices(numberOfVertices, -1), cliqueOffsets(1, 0) {
+}
+
+Partition::Partition(std::vector<int> cliqueIndexForVertex)
+    : cliqueIndices(std::move(cliqueIndexForVertex)) {
+    int largestCliqueIndex = -1;
+    for (int cliqueIndex : cliqueIndices) {
+        largestCliqueIndex = std::max(largestCliqueIndex, cliqueIndex);
+    }
+
+    cliqueOffsets.resize(largestCliqueIndex + 2);
+    buildCliques(largestCliqueIndex + 1);
+}
+
+int Partition::numberOfVertices() const {
+    return cliqueIndices.size();
+}
+
+int Partition::numberOfCliques() const {
+    return cliqueOffsets.empty() ? 0 : cliqueOffsets.size() - 1;
+}
+
+int Partition::numberOfNonEmptyCliques() const {
+    int numberOfNonEmptyCliques = 0;
+    for (int cliqueIndex = 0; cliqueIndex < numberOfCliques(); ++cliqueIndex) {
+        if (cliqueOffsets[cliqueIndex] != cliqueOffsets[cliqueIndex + 1]) {
+            numberOfNonEmptyCliques++;
+        }
+    }
+    return numberOfNonEmptyCliques;
+}
+
+int Partition::cliqueIndexForVertex(int vertex) const {
+    return cliqueIndices[vertex];
+}
+
+bool Partition::isAssigned(int vertex) const {
+    return cliqueIndices[vertex] != -1;
+}
+
+const std::vector<int>& Partition::cliqueIndexForVertexLookup() const {
+    return cliqueIndices;
+}
+
+Partition::Clique Partition::clique(int cliqueIndex) const {
+    const int* first = verticesOfCliques.data();
+    return Clique(first + cliqueOffsets[cliqueIndex], first + cliqueOffsets[cliqueIndex + 1]);
+}
+
+int Partition::cliqueSize(int cliqueIndex) const {
+    return cliqueOffsets[cliqueIndex + 1] - cliqueOffsets[cliqueIndex];
+}
+
+uint64_t Partition::canonicalHash() const {
+    // The smallest vertex of a clique identifies it independent of its index, as the vertices of each clique are sorted.
+    // So the sequence of the smallest vertices of the cliques of all vertices is the same as for the partition relabeled in first occurrence order.
+    uint64_t hash = 0xcbf29ce484222325;
+    for (int cliqueIndex : cliqueIndices) {
+        uint64_t smallestVertexOfClique = cliqueIndex == -1 ? 0 : verticesOfCliques[cliqueOffsets[cliqueIndex]] + 1;
+
+        // splitmix64 finalizer to mix the bits, see https://prng.di.unimi.it/splitmix64.c
+        uint64_t z = smallestVertexOfClique + 0x9e3779b97f4a7c15;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        z ^= z >> 31;
+
+        hash = (hash ^ z) * 0x100000001b3;
+    }
+    return hash;
+}
+
+void Partition::relabelInFirstOccurrenceOrder() {
+    // The offsets are not needed until the cliques are rebuilt, so they can hold the new index for each old index
+    std::vector<int>& newCliqueIndex = cliqueOffsets;
+    std::fill(newCliqueIndex.begin(), newCliqueIndex.end(), -1);
+
+    int numberOfRelabeledCliques = 0;
+    for (int& cliqueIndex : cliqueIndices) {
+        if (cliqueIndex == -1) {
+            continue;
+        }
+        if (newCliqueIndex[cliqueIndex] == -1) {
+            newCliqueIndex[cliqueIndex] = numberOfRelabeledCliques++;
+        }
+        cliqueIndex = newCliqueIndex[cliqueIndex];
+    }
+
+    // Shrinking never reallocates
+    cliqueOffsets.resize(numberOfRelabeledCliques + 1);
+    buildCliques(numberOfRelabeledCliques);
+}
+
+void Partition::buildCliques(int numberOfCliques) {
+    // Counting sort of the vertices by their clique index, cliqueOffsets[c + 1] first counts the vertices of clique c
+    std::fill(cliqueOffsets.begin(), cliqueOffsets.end(), 0);
+    int numberOfAssignedVertices = 0;
+    for (int cliqueIndex : cliqueIndices) {
+        if (cliqueIndex != -1) {
+            cliqueOffsets[cliqueIndex + 1]++;
+            numberOfAssignedVertices++;
+        }
+    }
+
+    // Afterwards cliqueOffsets[c + 1] is the end of clique c
+    for (int cliqueIndex = 0; cliqueIndex < numberOfCliques; ++cliqueIndex) {
+        cliqueOffsets[cliqueIndex + 1] += cliqueOffsets[cliqueIndex];
+    }
+
+    // Filling the cliques from the back moves cliqueOffsets[c + 1] to the start of clique c,
+    // and keeps the vertices of each clique in increasing order
+    verticesOfCliques.resize(numberOfAssignedVertices);
+    for (int vertex = numberOfVertices() - 1; vertex >= 0; --vertex) {
+        int cliqueIndex = cliqueIndices[vertex];
+        if (cliqueIndex != -1) {
+            verticesOfCliques[--cliqueOffsets[cliqueIndex + 1]] = vertex;
+        }
+    }
+
+    // Shift by one, so that clique c is [cliqueOffsets[c], cliqueOffsets[c + 1])
+    std::copy(cliqueOffsets.begin() + 1, cliqueOffsets.end(), cliqueOffsets.begin());
+    cliqueOffsets[numberOfCliques] = numberOfAssignedVertices;
+}
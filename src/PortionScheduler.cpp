@@ -0,0 +1,105 @@
+#include "PortionScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+PortionScheduler::PortionScheduler(std::vector<double> portions,
+                                   Strategy strategy,
+                                   int maximumStagnationCountPerPortion,
+                                   int firstPortionIndex,
+                                   double explorationFactor)
+    : portions(std::move(portions)),
+      strategy(strategy),
+      maximumStagnationCountPerPortion(maximumStagnationCountPerPortion),
+      explorationFactor(explorationFactor),
+      portionIndex(firstPortionIndex % this->portions.size()) {
+    portionStatistics.resize(this->portions.size());
+}
+
+int PortionScheduler::currentPortionIndex() const {
+    return portionIndex;
+}
+
+double PortionScheduler::currentPortion() const {
+    return portions[portionIndex];
+}
+
+double PortionScheduler::portion(int portionIndex) const {
+    return portions[portionIndex];
+}
+
+void PortionScheduler::recordIteration(int usedPortionIndex,
+                                       int improvement,
+                                       bool foundNewBest,
+                                       double seconds) {
+    PortionStatistics& statistics = portionStatistics[usedPortionIndex];
+    statistics.numberOfIterations++;
+    statistics.numberOfNewBestSolutions += foundNewBest;
+    statistics.totalImprovement += std::max(improvement, 0);
+    statistics.seconds += seconds;
+    numberOfIterations++;
+
+    if (strategy == UPPER_CONFIDENCE_BOUND) {
+        portionIndex = portionWithHighestUpperConfidenceBound();
+        return;
+    }
+
+    // Adjust portion and reset stagnation counter if needed
+    if (foundNewBest) {
+        stagnationCounter = 0;
+    } else {
+        stagnationCounter++;
+    }
+
+    if (stagnationCounter >= maximumStagnationCountPerPortion) {
+        portionIndex = (portionIndex + 1) % portions.size();
+        stagnationCounter = 0;
+    }
+}
+
+const std::vector<PortionScheduler::PortionStatistics>& PortionScheduler::statistics() const {
+    return portionStatistics;
+}
+
+int PortionScheduler::stagnationCount() const {
+    return stagnationCounter;
+}
+
+void PortionScheduler::restore(int portionIndex, int stagnationCounter) {
+    this->portionIndex = portionIndex % portions.size();
+    this->stagnationCounter = stagnationCounter;
+}
+
+int PortionScheduler::portionWithHighestUpperConfidenceBound() const {
+    // Every portion is tried once before the bounds are compared
+    for (int i = 0; i < portions.size(); ++i) {
+        if (portionStatistics[i].numberOfIterations == 0) {
+            return i;
+        }
+    }
+
+    // The rewards are scaled by the best rate, so that they are in [0, 1] like UCB1 expects
+    std::vector<double> improvementPerSecond(portions.size());
+    double highestImprovementPerSecond = 0.0;
+    for (int i = 0; i < portions.size(); ++i) {
+        const PortionStatistics& statistics = portionStatistics[i];
+        improvementPerSecond[i] = statistics.totalImprovement / std::max(statistics.seconds, 1e-9);
+        highestImprovementPerSecond = std::max(highestImprovementPerSecond, improvementPerSecond[i]);
+    }
+
+    int bestPortionIndex = 0;
+    double highestUpperConfidenceBound = -1.0;
+    for (int i = 0; i < portions.size(); ++i) {
+        double reward = highestImprovementPerSecond > 0 ? improvementPerSecond[i] / highestImprovementPerSecond : 0.0;
+        double upperConfidenceBound = reward + explorationFactor * std::sqrt(std::log(numberOfIterations) / portionStatistics[i].numberOfIterations);
+
+        if (upperConfidenceBound > highestUpperConfidenceBound) {
+            highestUpperConfidenceBound = upperConfidenceBound;
+            bestPortionIndex = i;
+        }
+    }
+
+    return bestPortionIndex;
+}
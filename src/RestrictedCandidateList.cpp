@@ -0,0 +1,147 @@
+#include "RestrictedCandidateList.h"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+// A move is better if it has a higher benefit, ties are broken by the lower clique index
+bool isBetterMove(const std::pair<int, int>& a, const std::pair<int, int>& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+}  // namespace
+
+RestrictedCandidateList::RestrictedCandidateList(const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
+                                                 int lengthOfRandomCandidateList,
+                                                 const std::vector<int>& activeCliques)
+    : lengthOfRandomCandidateList(lengthOfRandomCandidateList),
+      numberOfVertices(benefitOfAddingVertexToClique.size()),
+      activeCliques(activeCliques) {
+    bestMovesOfVertex.resize(numberOfVertices * lengthOfRandomCandidateList);
+    numberOfBestMovesOfVertex.resize(numberOfVertices, 0);
+
+    for (int vertexIndex = 0; vertexIndex < numberOfVertices; ++vertexIndex) {
+        rebuildVertex(benefitOfAddingVertexToClique, vertexIndex);
+    }
+}
+
+void RestrictedCandidateList::updateClique(const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
+                                           int cliqueIndex) {
+    bool allActiveCliquesAreStored = activeCliques.size() <= lengthOfRandomCandidateList;
+
+    for (int vertexIndex = 0; vertexIndex < numberOfVertices; ++vertexIndex) {
+        int benefit = benefitOfAddingVertexToClique[vertexIndex][cliqueIndex];
+
+        auto first = bestMovesOfVertex.begin() + vertexIndex * lengthOfRandomCandidateList;
+        auto last = first + numberOfBestMovesOfVertex[vertexIndex];
+        auto storedMove = std::find_if(first, last, [cliqueIndex](const std::pair<int, int>& move) { return move.second == cliqueIndex; });
+
+        if (storedMove == last) {
+            offerMove(vertexIndex, cliqueIndex, benefit);
+            continue;
+        }
+
+        int previousBenefit = storedMove->first;
+        storedMove->first = benefit;
+
+        // If a stored move got worse, one of the moves that are not stored might be better now
+        if (benefit < previousBenefit && !allActiveCliquesAreStored) {
+            rebuildVertex(benefitOfAddingVertexToClique, vertexIndex);
+        } else {
+            restoreOrder(vertexIndex, std::distance(first, storedMove));
+        }
+    }
+}
+
+void RestrictedCandidateList::activateClique(const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
+                                             int cliqueIndex) {
+    activeCliques.push_back(cliqueIndex);
+
+    for (int vertexIndex = 0; vertexIndex < numberOfVertices; ++vertexIndex) {
+        offerMove(vertexIndex, cliqueIndex, benefitOfAddingVertexToClique[vertexIndex][cliqueIndex]);
+    }
+}
+
+void RestrictedCandidateList::removeVertex(int vertexIndex) {
+    int lastVertexIndex = numberOfVertices - 1;
+
+    if (vertexIndex != lastVertexIndex) {
+        std::copy_n(bestMovesOfVertex.begin() + lastVertexIndex * lengthOfRandomCandidateList,
+                    lengthOfRandomCandidateList,
+                    bestMovesOfVertex.begin() + vertexIndex * lengthOfRandomCandidateList);
+        numberOfBestMovesOfVertex[vertexIndex] = numberOfBestMovesOfVertex[lastVertexIndex];
+    }
+
+    numberOfVertices--;
+    bestMovesOfVertex.resize(numberOfVertices * lengthOfRandomCandidateList);
+    numberOfBestMovesOfVertex.resize(numberOfVertices);
+}
+
+const std::vector<std::tuple<int, int, int>>& RestrictedCandidateList::getBestMoves() {
+    bestMoves.clear();
+
+    for (int vertexIndex = 0; vertexIndex < numberOfVertices; ++vertexIndex) {
+        for (int i = 0; i < numberOfBestMovesOfVertex[vertexIndex]; ++i) {
+            const auto& [benefit, cliqueIndex] = bestMovesOfVertex[vertexIndex * lengthOfRandomCandidateList + i];
+            bestMoves.push_back({vertexIndex, cliqueIndex, benefit});
+        }
+    }
+
+    if (bestMoves.size() > lengthOfRandomCandidateList) {
+        std::nth_element(bestMoves.begin(), bestMoves.begin() + lengthOfRandomCandidateList - 1, bestMoves.end(),
+                         [](const std::tuple<int, int, int>& a, const std::tuple<int, int, int>& b) {
+                             if (std::get<2>(a) != std::get<2>(b)) {
+                                 return std::get<2>(a) > std::get<2>(b);
+                             }
+                             return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+                         });
+        bestMoves.resize(lengthOfRandomCandidateList);
+    }
+
+    return bestMoves;
+}
+
+void RestrictedCandidateList::rebuildVertex(const std::vector<std::vector<int>>& benefitOfAddingVertexToClique,
+                                            int vertexIndex) {
+    numberOfBestMovesOfVertex[vertexIndex] = 0;
+
+    for (int cliqueIndex : activeCliques) {
+        offerMove(vertexIndex, cliqueIndex, benefitOfAddingVertexToClique[vertexIndex][cliqueIndex]);
+    }
+}
+
+void RestrictedCandidateList::offerMove(int vertexIndex,
+                                        int cliqueIndex,
+                                        int benefit) {
+    int& numberOfMoves = numberOfBestMovesOfVertex[vertexIndex];
+    auto first = bestMovesOfVertex.begin() + vertexIndex * lengthOfRandomCandidateList;
+    std::pair<int, int> move = {benefit, cliqueIndex};
+
+    if (numberOfMoves < lengthOfRandomCandidateList) {
+        first[numberOfMoves] = move;
+        numberOfMoves++;
+        restoreOrder(vertexIndex, numberOfMoves - 1);
+    } else if (isBetterMove(move, first[numberOfMoves - 1])) {
+        // replace the worst stored move of the vertex
+        first[numberOfMoves - 1] = move;
+        restoreOrder(vertexIndex, numberOfMoves - 1);
+    }
+}
+
+void RestrictedCandidateList::restoreOrder(int vertexIndex,
+                                           int changedPosition) {
+    auto first = bestMovesOfVertex.begin() + vertexIndex * lengthOfRandomCandidateList;
+    int numberOfMoves = numberOfBestMovesOfVertex[vertexIndex];
+
+    // Only a single entry changed, so it is enough to move it to the front or the back until it is in order again
+    int position = changedPosition;
+    while (position > 0 && isBetterMove(first[position], first[position - 1])) {
+        std::swap(first[position], first[position - 1]);
+        position--;
+    }
+    while (position < numberOfMoves - 1 && isBetterMove(first[position + 1], first[position])) {
+        std::swap(first[position], first[position + 1]);
+        position++;
+    }
+}
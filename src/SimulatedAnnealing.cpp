@@ -5,9 +5,10 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
-#include <list>
+#include <optional>
 #include <random>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "GreedyAdding.h"
@@ -22,46 +23,106 @@
  */
 bool SimulatedAnnealing::allowSingletonMoves = false;
 
-std::vector<std::list<int>> SimulatedAnnealing::run(const std::vector<std::list<int>>& initialPartition,
-                                                    const std::vector<int>& vertices,
-                                                    const std::vector<std::vector<int>>& weights,
-                                                    double initialTemperature,
-                                                    double batchSizeScaleFactor,
-                                                    double cooldownFactor,
-                                                    double minimalTransitionRatio) {
+std::pair<Partition, int> SimulatedAnnealing::run(const Partition& initialPartition,
+                                                  const std::vector<int>& vertices,
+                                                  const std::vector<std::vector<int>>& weights,
+                                                  double initialTemperature,
+                                                  double batchSizeScaleFactor,
+                                                  double cooldownFactor,
+                                                  double minimalTransitionRatio,
+                                                  std::optional<int> partitionValue,
+                                                  const CancellationToken& cancellationToken) {
+    return runOnActiveVertices(initialPartition, vertices, vertices, weights, initialTemperature, batchSizeScaleFactor, cooldownFactor, minimalTransitionRatio, partitionValue, 0.0, cancellationToken);
+}
+
+std::pair<Partition, int> SimulatedAnnealing::runOnActiveVertices(const Partition& initialPartition,
+                                                                  const std::vector<int>& activeVertices,
+                                                                  const std::vector<int>& vertices,
+                                                                  const std::vector<std::vector<int>>& weights,
+                                                                  double initialTemperature,
+                                                                  double batchSizeScaleFactor,
+                                                                  double cooldownFactor,
+                                                                  double minimalTransitionRatio,
+                                                                  std::optional<int> partitionValue,
+                                                                  double relaxationTemperatureFactor,
+                                                                  const CancellationToken& cancellationToken) {
     double currentTemperature = initialTemperature;
 
     // move all non-empty partitions to the front
-    std::vector<std::list<int>> sortedPartition = initialPartition;
-    auto indexOfFirstEmptyClique = std::partition(
-        sortedPartition.begin(), sortedPartition.end(),
-        [](const std::list<int>& clique) { return !clique.empty(); });
+    Partition sortedPartition = initialPartition;
+    sortedPartition.relabelInFirstOccurrenceOrder();
 
-    int numberOfCliques = std::distance(sortedPartition.begin(), indexOfFirstEmptyClique);
+    int numberOfCliques = sortedPartition.numberOfCliques();
     int numberOfVertices = vertices.size();
-    int batchSize = static_cast<int>(std::round(batchSizeScaleFactor * numberOfCliques * numberOfVertices));
 
     std::vector<std::vector<int>> edgeWeightSumsBetweenVertexAndClique = initializeEdgeWeightSumsBetweenVertexAndClique(vertices, weights, sortedPartition, numberOfCliques);
     std::vector<int> numberOfVerticesInCliques = initializeNumberOfVerticesInCliques(sortedPartition, vertices.size());
     std::vector<int> cliqueIndexForVertex = initializeCliqueIndexForVertexLookup(sortedPartition, numberOfVertices);
 
-    double currentPartitionValue = utils::valueForPartition(sortedPartition, weights);
+    double currentPartitionValue = partitionValue.has_value() ? *partitionValue : utils::valueForPartition(sortedPartition, weights);
     std::vector<int> bestPartitionAsCliqueIndexVector = cliqueIndexForVertex;
     double bestPartitionValue = currentPartitionValue;
-    int stagnationCounter = 0;
-
-    int vertexMovedPreviously = 0;
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
+    // The batch only has to be large enough for the vertices that are moved
+    if (!activeVertices.empty()) {
+        int batchSize = std::max(1, static_cast<int>(std::round(batchSizeScaleFactor * numberOfCliques * activeVertices.size())));
+        currentTemperature = anneal(activeVertices, batchSize, initialTemperature, cooldownFactor, minimalTransitionRatio, weights,
+                                    numberOfVerticesInCliques, edgeWeightSumsBetweenVertexAndClique, cliqueIndexForVertex,
+                                    currentPartitionValue, bestPartitionAsCliqueIndexVector, bestPartitionValue, cancellationToken);
+    }
+
+    // Let all vertices adapt to the changed active vertices at a lower temperature
+    if (relaxationTemperatureFactor > 0 && !cancellationToken.isCancelled()) {
+        int batchSize = static_cast<int>(std::round(batchSizeScaleFactor * numberOfCliques * numberOfVertices));
+        currentTemperature = anneal(vertices, batchSize, relaxationTemperatureFactor * initialTemperature, cooldownFactor, minimalTransitionRatio, weights,
+                                    numberOfVerticesInCliques, edgeWeightSumsBetweenVertexAndClique, cliqueIndexForVertex,
+                                    currentPartitionValue, bestPartitionAsCliqueIndexVector, bestPartitionValue, cancellationToken);
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = endTime - startTime;
+    if (duration > std::chrono::seconds(10)) {
+        std::cout << "Simulated Annealing took " << duration.count() << " seconds" << std::endl;
+        std::cout << "Temperature: " << currentTemperature << std::endl;
+    }
+
+    // All changes of the value are integers, so the tracked value is exact
+    return {Partition(std::move(bestPartitionAsCliqueIndexVector)), static_cast<int>(bestPartitionValue)};
+}
+
+double SimulatedAnnealing::anneal(const std::vector<int>& verticesToMove,
+                                  int batchSize,
+                                  double initialTemperature,
+                                  double cooldownFactor,
+                                  double minimalTransitionRatio,
+                                  const std::vector<std::vector<int>>& weights,
+                                  std::vector<int>& numberOfVerticesInCliques,
+                                  std::vector<std::vector<int>>& edgeWeightSumsBetweenVertexAndClique,
+                                  std::vector<int>& cliqueIndexForVertex,
+                                  double& currentPartitionValue,
+                                  std::vector<int>& bestPartitionAsCliqueIndexVector,
+                                  double& bestPartitionValue,
+                                  const CancellationToken& cancellationToken) {
+    double currentTemperature = initialTemperature;
+    int stagnationCounter = 0;
+
+    int vertexMovedPreviously = verticesToMove[0];
+
     while (stagnationCounter < 5) {
         int numberOfTransitions = 0;
 
         for (int i = 0; i < batchSize; ++i) {
+            // A batch can take long for large instances, so the token is also checked within a batch
+            if (i % 1024 == 0 && cancellationToken.isCancelled()) {
+                return currentTemperature;
+            }
+
             bool performedTransition;
             double rewardForBestMove;
             std::tie(performedTransition, rewardForBestMove, vertexMovedPreviously) = step(numberOfVerticesInCliques,
-                                                                                           vertices,
+                                                                                           verticesToMove,
                                                                                            weights,
                                                                                            edgeWeightSumsBetweenVertexAndClique,
                                                                                            cliqueIndexForVertex,
@@ -98,36 +159,17 @@ std::vector<std::list<int>> SimulatedAnnealing::run(const std::vector<std::list<
         }
     }
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> duration = endTime - startTime;
-    if (duration > std::chrono::seconds(10)) {
-        std::cout << "Simulated Annealing took " << duration.count() << " seconds" << std::endl;
-        std::cout << "Temperature: " << currentTemperature << std::endl;
-    }
-
-    std::vector<std::list<int>> bestPartition = cliqueIndexVectorToPartition(bestPartitionAsCliqueIndexVector, numberOfVertices);
-
-    return bestPartition;
-}
-
-std::vector<std::list<int>> SimulatedAnnealing::cliqueIndexVectorToPartition(const std::vector<int>& cliqueIndexForVertex, int numberOfVertices) {
-    std::vector<std::list<int>> partition(numberOfVertices);
-
-    for (int vertexIndex = 0; vertexIndex < cliqueIndexForVertex.size(); ++vertexIndex) {
-        partition[cliqueIndexForVertex[vertexIndex]].push_back(vertexIndex);
-    }
-
-    return partition;
+    return currentTemperature;
 }
 
 std::tuple<bool, double, int> SimulatedAnnealing::step(std::vector<int>& numberOfVerticesInCliques,
-                                                       const std::vector<int>& vertices,
+                                                       const std::vector<int>& verticesToMove,
                                                        const std::vector<std::vector<int>>& weights,
                                                        std::vector<std::vector<int>>& benefitOfMoving,
                                                        std::vector<int>& cliqueIndexForVertex,
                                                        int vertexMovedPreviously,
                                                        double currentTemperature) {
-    int vertexToMove = RandomNumberGenerator::getRandomNumberBelow(vertices.size());
+    int vertexToMove = verticesToMove[RandomNumberGenerator::getRandomNumberBelow(verticesToMove.size())];
     int cliqueToMoveFrom = cliqueIndexForVertex[vertexToMove];
     int cliqueToMovePreviousVertexFrom = cliqueIndexForVertex[vertexMovedPreviously];
 
@@ -405,29 +447,25 @@ bool SimulatedAnnealing::makeWorseningMove(double rewardForBestMove,
     return RandomNumberGenerator::getRandomFloatBetweenZeroAndOne() < probabilityOfMakingWorseningMove;
 }
 
-std::vector<int> SimulatedAnnealing::initializeNumberOfVerticesInCliques(const std::vector<std::list<int>>& currentPartition,
+std::vector<int> SimulatedAnnealing::initializeNumberOfVerticesInCliques(const Partition& currentPartition,
                                                                          int numberOfVertices) {
     std::vector<int> numberOfVerticesInCliques(numberOfVertices, 0);
-    for (int i = 0; i < currentPartition.size(); ++i) {
-        numberOfVerticesInCliques[i] = currentPartition[i].size();
+    for (int i = 0; i < currentPartition.numberOfCliques(); ++i) {
+        numberOfVerticesInCliques[i] = currentPartition.cliqueSize(i);
     }
     return numberOfVerticesInCliques;
 }
 
-std::vector<int> SimulatedAnnealing::initializeCliqueIndexForVertexLookup(const std::vector<std::list<int>>& currentPartition,
+std::vector<int> SimulatedAnnealing::initializeCliqueIndexForVertexLookup(const Partition& currentPartition,
                                                                           int numberOfVertices) {
-    std::vector<int> cliqueIndexForVertex(numberOfVertices, -1);
-    for (size_t i = 0; i < currentPartition.size(); ++i) {
-        for (int vertex : currentPartition[i]) {
-            cliqueIndexForVertex[vertex] = i;
-        }
-    }
+    std::vector<int> cliqueIndexForVertex = currentPartition.cliqueIndexForVertexLookup();
+    cliqueIndexForVertex.resize(numberOfVertices, -1);
     return cliqueIndexForVertex;
 }
 
 std::vector<std::vector<int>> SimulatedAnnealing::initializeEdgeWeightSumsBetweenVertexAndClique(const std::vector<int>& vertices,
                                                                                                  const std::vector<std::vector<int>>& weights,
-                                                                                                 const std::vector<std::list<int>>& currentPartition,
+                                                                                                 const Partition& currentPartition,
                                                                                                  int numberOfNonEmptyCliques) {
     size_t numVertices = vertices.size();
 
@@ -438,7 +476,7 @@ std::vector<std::vector<int>> SimulatedAnnealing::initializeEdgeWeightSumsBetwee
             int vertex = vertices[vertexIndex];
             int connections = 0;
 
-            for (int otherVertex : currentPartition[cliqueIndex]) {
+            for (int otherVertex : currentPartition.clique(cliqueIndex)) {
                 connections += weights[vertex][otherVertex];
             }
 
@@ -486,14 +524,12 @@ double SimulatedAnnealing::CalculateSimulatedAnnealingTemperature(const std::vec
 
     while (true) {
         int numberOfTransitions = 0;
-        std::vector<std::list<int>> partition = GreedyAdding::runForEmptyPartition(vertices, weights, 2);
+        Partition partition = GreedyAdding::runForEmptyPartition(vertices, weights, 2);
 
         // move all non-empty partitions to the front
-        auto indexOfFirstEmptyClique = std::partition(
-            partition.begin(), partition.end(),
-            [](const std::list<int>& clique) { return !clique.empty(); });
+        partition.relabelInFirstOccurrenceOrder();
 
-        int numberOfCliques = std::distance(partition.begin(), indexOfFirstEmptyClique);
+        int numberOfCliques = partition.numberOfCliques();
         int numberOfVertices = vertices.size();
         int batchSize = static_cast<int>(std::round(batchSizeScaleFactor * numberOfCliques * numberOfVertices));
 
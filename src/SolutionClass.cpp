@@ -1,45 +1,57 @@
 #include "SolutionClass.h"
 
-#include <list>
+#include <cassert>
+#include <utility>
 #include <vector>
 
 #include "utils.h"
 
-SolutionWithValueAndIndexLookup::SolutionWithValueAndIndexLookup(const std::vector<std::list<int>>& partition,
-                                                                 const std::vector<std::vector<int>>& weights) : partition(partition) {
-    value = utils::valueForPartition(partition, weights);
+SolutionWithValueAndIndexLookup::SolutionWithValueAndIndexLookup(Partition partition,
+                                                                 const std::vector<std::vector<int>>& weights) : partition(std::move(partition)) {
+    value = utils::valueForPartition(this->partition, weights);
+    hash = this->partition.canonicalHash();
+}
 
-    int numberOfVertices = weights.size();
-    int numberOfCliques = partition.size();
-    cliqueIndexForVertex.resize(numberOfVertices);
+SolutionWithValueAndIndexLookup::SolutionWithValueAndIndexLookup(Partition partition,
+                                                                 int value,
+                                                                 [[maybe_unused]] const std::vector<std::vector<int>>& weights) : partition(std::move(partition)), value(value) {
+    assert(value == utils::valueForPartition(this->partition, weights));
+    hash = this->partition.canonicalHash();
+}
 
-    for (size_t i = 0; i < numberOfCliques; ++i) {
-        for (int vertex : partition[i]) {
-            cliqueIndexForVertex[vertex] = i;
-        }
-    }
+int SolutionWithValueAndIndexLookup::cliqueIndexForVertex(int vertex) const {
+    return partition.cliqueIndexForVertex(vertex);
+}
+
+const std::vector<int>& SolutionWithValueAndIndexLookup::cliqueIndexForVertexLookup() const {
+    return partition.cliqueIndexForVertexLookup();
 }
 
 bool SolutionWithValueAndIndexLookup::operator==(const SolutionWithValueAndIndexLookup& other) const {
-    if (value != other.value) {
+    if (value != other.value || hash != other.hash) {
         return false;
     }
 
-    if (partition.size() != other.partition.size()) {
+    if (partition.numberOfVertices() != other.partition.numberOfVertices()) {
+        return false;
+    }
+
+    if (partition.numberOfNonEmptyCliques() != other.partition.numberOfNonEmptyCliques()) {
         return false;
     }
 
     // check for each vertex if it is in the same clique in both solutions
-    for (auto& clique : partition) {
+    for (int cliqueIndex = 0; cliqueIndex < partition.numberOfCliques(); ++cliqueIndex) {
+        Partition::Clique clique = partition.clique(cliqueIndex);
         if (clique.empty()) {
             continue;
         }
 
-        int someVertexInClique = clique.front();
-        int cliqueIndexInOtherSolution = other.cliqueIndexForVertex[someVertexInClique];
+        int someVertexInClique = *clique.begin();
+        int cliqueIndexInOtherSolution = other.cliqueIndexForVertex(someVertexInClique);
 
         for (int vertex : clique) {
-            if (other.cliqueIndexForVertex[vertex] != cliqueIndexInOtherSolution) {
+            if (other.cliqueIndexForVertex(vertex) != cliqueIndexInOtherSolution) {
                 return false;
             }
         }
@@ -58,4 +70,4 @@ bool SolutionWithValueAndIndexLookup::operator<(const SolutionWithValueAndIndexL
 
 bool SolutionWithValueAndIndexLookup::operator>(const SolutionWithValueAndIndexLookup& other) const {
     return value > other.value;
-}
\ No newline at end of file
+}
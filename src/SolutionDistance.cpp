@@ -1,36 +1,326 @@
-#include <list>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "Partition.h"
 #include "PartitionDistances.h"
-#include "partition-comparison.hxx"
+#include "ThreadPool.h"
 
-std::vector<std::vector<float>> computeUpperDistanceMatrix(const std::vector<std::vector<int>>& solutions,
-                                                           Metric metric) {
-    int numberOfSolutions = solutions.size();
+std::pair<uint64_t, uint64_t> PartitionDistanceCalculator::prepare(const std::vector<int>& cliqueIndexForVertex1,
+                                                           const std::vector<int>& cliqueIndexForVertex2) {
+    int numberOfVertices = cliqueIndexForVertex1.size();
+    int numberOfCliques1 = *std::max_element(cliqueIndexForVertex1.begin(), cliqueIndexForVertex1.end()) + 2;
+    int numberOfCliques2 = *std::max_element(cliqueIndexForVertex2.begin(), cliqueIndexForVertex2.end()) + 2;
 
-    std::vector<std::vector<float>> distances(numberOfSolutions, std::vector<float>(numberOfSolutions));
+    // assign only allocates if the buffers are too small
+    cliqueOffsets1.assign(numberOfCliques1 + 1, 0);
+    cliqueSizes2.assign(numberOfCliques2, 0);
+    overlapCounts.assign(numberOfCliques2, 0);
+    verticesOfCliques1.resize(numberOfVertices);
 
-    for (int i = 0; i < numberOfSolutions; ++i) {
-        for (int j = i + 1; j < numberOfSolutions; ++j) {
-            double distance = 0.0;
+    for (int vertex = 0; vertex < numberOfVertices; ++vertex) {
+        cliqueOffsets1[cliqueIndexForVertex1[vertex] + 2]++;
+        cliqueSizes2[cliqueIndexForVertex2[vertex] + 1]++;
+    }
+
+    uint64_t squaredCliqueSizes1 = 0;
+    for (int cliqueIndex = 0; cliqueIndex < numberOfCliques1; ++cliqueIndex) {
+        uint64_t cliqueSize = cliqueOffsets1[cliqueIndex + 1];
+        squaredCliqueSizes1 += cliqueSize * cliqueSize;
+        cliqueOffsets1[cliqueIndex + 1] += cliqueOffsets1[cliqueIndex];
+    }
+
+    uint64_t squaredCliqueSizes2 = 0;
+    for (uint64_t cliqueSize : cliqueSizes2) {
+        squaredCliqueSizes2 += cliqueSize * cliqueSize;
+    }
+
+    // Counting sort, afterwards clique c is [cliqueOffsets1[c], cliqueOffsets1[c + 1])
+    for (int vertex = 0; vertex < numberOfVertices; ++vertex) {
+        verticesOfCliques1[cliqueOffsets1[cliqueIndexForVertex1[vertex] + 1]++] = vertex;
+    }
+    std::copy_backward(cliqueOffsets1.begin(), cliqueOffsets1.end() - 1, cliqueOffsets1.end());
+    cliqueOffsets1[0] = 0;
+
+    return {squaredCliqueSizes1, squaredCliqueSizes2};
+}
+
+uint64_t PartitionDistanceCalculator::squaredOverlaps(Partition::Clique clique1,
+                                              const std::vector<int>& cliqueIndexForVertex2) {
+    // (c + 1)^2 - c^2 = 2c + 1
+    uint64_t sum = 0;
+    for (int vertex : clique1) {
+        sum += 2 * overlapCounts[cliqueIndexForVertex2[vertex] + 1]++ + 1;
+    }
+
+    // Only the touched counts are reset, so the cost doesn't depend on the number of cliques
+    for (int vertex : clique1) {
+        overlapCounts[cliqueIndexForVertex2[vertex] + 1] = 0;
+    }
+    return sum;
+}
+
+int64_t PartitionDistanceCalculator::numberOfDisagreeingPairs(const std::vector<int>& cliqueIndexForVertex1,
+                                                      const std::vector<int>& cliqueIndexForVertex2) {
+    if (cliqueIndexForVertex1.size() < 2) {
+        return 0;
+    }
+
+    auto [squaredCliqueSizes1, squaredCliqueSizes2] = prepare(cliqueIndexForVertex1, cliqueIndexForVertex2);
+
+    uint64_t sumOfSquaredOverlaps = 0;
+    for (int cliqueIndex = 0; cliqueIndex + 1 < cliqueOffsets1.size(); ++cliqueIndex) {
+        const int* first = verticesOfCliques1.data();
+        sumOfSquaredOverlaps += squaredOverlaps(Partition::Clique(first + cliqueOffsets1[cliqueIndex], first + cliqueOffsets1[cliqueIndex + 1]),
+                                                cliqueIndexForVertex2);
+    }
+
+    // Pairs that are joined in one partition and cut in the other, the false joins and false cuts of andres::RandError
+    return (squaredCliqueSizes1 + squaredCliqueSizes2 - 2 * sumOfSquaredOverlaps) / 2;
+}
+
+double PartitionDistanceCalculator::randError(const std::vector<int>& cliqueIndexForVertex1,
+                                      const std::vector<int>& cliqueIndexForVertex2) {
+    return randErrorForDisagreeingPairs(numberOfDisagreeingPairs(cliqueIndexForVertex1, cliqueIndexForVertex2), cliqueIndexForVertex1.size());
+}
+
+std::pair<int64_t, int64_t> PartitionDistanceCalculator::boundDisagreeingPairs(const Partition& partition1,
+                                                                        const Partition& partition2,
+                                                                        double threshold) {
+    int64_t numberOfVertices = partition1.numberOfVertices();
+    if (numberOfVertices < 2) {
+        return {0, 0};
+    }
+
+    const std::vector<int>& cliqueIndexForVertex2 = partition2.cliqueIndexForVertexLookup();
+
+    int64_t squaredCliqueSizes1 = 0;
+    int64_t numberOfAssignedVertices1 = 0;
+    for (int cliqueIndex = 0; cliqueIndex < partition1.numberOfCliques(); ++cliqueIndex) {
+        int64_t cliqueSize = partition1.cliqueSize(cliqueIndex);
+        squaredCliqueSizes1 += cliqueSize * cliqueSize;
+        numberOfAssignedVertices1 += cliqueSize;
+    }
+
+    // Unassigned vertices are not in any clique of the first partition, the exact kernel groups them itself
+    if (numberOfAssignedVertices1 != numberOfVertices) {
+        int64_t exactNumberOfDisagreeingPairs = numberOfDisagreeingPairs(partition1.cliqueIndexForVertexLookup(), cliqueIndexForVertex2);
+        return {exactNumberOfDisagreeingPairs, exactNumberOfDisagreeingPairs};
+    }
+
+    // cliqueSizes2 counts the vertices of each clique of the second partition that are not processed yet,
+    // shifted by one for the unassigned vertices
+    int numberOfCliques2 = partition2.numberOfCliques();
+    cliqueSizes2.assign(numberOfCliques2 + 1, 0);
+    overlapCounts.assign(numberOfCliques2 + 1, 0);
+    int64_t squaredCliqueSizes2 = 0;
+    int numberOfAssignedVertices2 = 0;
+    for (int cliqueIndex = 0; cliqueIndex < numberOfCliques2; ++cliqueIndex) {
+        int64_t cliqueSize = partition2.cliqueSize(cliqueIndex);
+        cliqueSizes2[cliqueIndex + 1] = cliqueSize;
+        squaredCliqueSizes2 += cliqueSize * cliqueSize;
+        numberOfAssignedVertices2 += cliqueSize;
+    }
+    cliqueSizes2[0] = numberOfVertices - numberOfAssignedVertices2;
+    squaredCliqueSizes2 += static_cast<int64_t>(cliqueSizes2[0]) * cliqueSizes2[0];
+
+    auto isBelow = [&](int64_t numberOfDisagreeingPairs) {
+        return randErrorForDisagreeingPairs(numberOfDisagreeingPairs, numberOfVertices) < threshold;
+    };
+
+    // The disagreeing pairs are (squaredCliqueSizes1 + squaredCliqueSizes2) / 2 - the sum of the squared overlaps.
+    // The squared overlaps of the remaining cliques sum up to at least the number of remaining vertices,
+    // and to at most the squared sizes of their cliques in either partition, which gives the bounds.
+    int64_t halfSumOfSquaredCliqueSizes = (squaredCliqueSizes1 + squaredCliqueSizes2) / 2;
+    int64_t sumOfSquaredOverlaps = 0;
+    int64_t remainingVertices = numberOfVertices;
+    int64_t remainingSquaredCliqueSizes1 = squaredCliqueSizes1;
+    int64_t remainingSquaredCliqueSizes2 = squaredCliqueSizes2;
+
+    for (int cliqueIndex = 0; cliqueIndex < partition1.numberOfCliques(); ++cliqueIndex) {
+        Partition::Clique clique1 = partition1.clique(cliqueIndex);
+        if (clique1.empty()) {
+            continue;
+        }
+
+        sumOfSquaredOverlaps += squaredOverlaps(clique1, cliqueIndexForVertex2);
+        remainingVertices -= clique1.size();
+        remainingSquaredCliqueSizes1 -= static_cast<int64_t>(clique1.size()) * clique1.size();
+        for (int vertex : clique1) {
+            int& remainingCliqueSize2 = cliqueSizes2[cliqueIndexForVertex2[vertex] + 1];
+            remainingSquaredCliqueSizes2 -= 2 * remainingCliqueSize2 - 1;
+            remainingCliqueSize2--;
+        }
+
+        int64_t leastDisagreeingPairs = halfSumOfSquaredCliqueSizes - sumOfSquaredOverlaps - std::min(remainingSquaredCliqueSizes1, remainingSquaredCliqueSizes2);
+        int64_t mostDisagreeingPairs = halfSumOfSquaredCliqueSizes - sumOfSquaredOverlaps - remainingVertices;
+        if (!isBelow(leastDisagreeingPairs) || isBelow(mostDisagreeingPairs)) {
+            return {leastDisagreeingPairs, mostDisagreeingPairs};
+        }
+    }
+
+    return {halfSumOfSquaredCliqueSizes - sumOfSquaredOverlaps, halfSumOfSquaredCliqueSizes - sumOfSquaredOverlaps};
+}
+
+double PartitionDistanceCalculator::variationOfInformation(const std::vector<int>& cliqueIndexForVertex1,
+                                                          const std::vector<int>& cliqueIndexForVertex2) {
+    if (cliqueIndexForVertex1.empty()) {
+        return 0.0;
+    }
+
+    prepare(cliqueIndexForVertex1, cliqueIndexForVertex2);
+    double numberOfVertices = cliqueIndexForVertex1.size();
+
+    // Entropies of both partitions
+    double entropy1 = 0.0;
+    for (int cliqueIndex = 0; cliqueIndex + 1 < cliqueOffsets1.size(); ++cliqueIndex) {
+        int cliqueSize = cliqueOffsets1[cliqueIndex + 1] - cliqueOffsets1[cliqueIndex];
+        if (cliqueSize > 0) {
+            double probability = cliqueSize / numberOfVertices;
+            entropy1 -= probability * std::log2(probability);
+        }
+    }
+
+    double entropy2 = 0.0;
+    for (int cliqueSize : cliqueSizes2) {
+        if (cliqueSize > 0) {
+            double probability = cliqueSize / numberOfVertices;
+            entropy2 -= probability * std::log2(probability);
+        }
+    }
+
+    // Mutual information, with the overlaps of each clique of the first partition counted in overlapCounts
+    double mutualInformation = 0.0;
+    for (int cliqueIndex = 0; cliqueIndex + 1 < cliqueOffsets1.size(); ++cliqueIndex) {
+        const int* first = verticesOfCliques1.data() + cliqueOffsets1[cliqueIndex];
+        const int* last = verticesOfCliques1.data() + cliqueOffsets1[cliqueIndex + 1];
+        double cliqueSize1 = last - first;
+
+        for (const int* vertex = first; vertex != last; ++vertex) {
+            overlapCounts[cliqueIndexForVertex2[*vertex] + 1]++;
+        }
+
+        // Each overlap is added at the first of its vertices and then reset
+        for (const int* vertex = first; vertex != last; ++vertex) {
+            int shiftedCliqueIndex2 = cliqueIndexForVertex2[*vertex] + 1;
+            if (overlapCounts[shiftedCliqueIndex2] > 0) {
+                double overlap = overlapCounts[shiftedCliqueIndex2];
+                mutualInformation += overlap / numberOfVertices * std::log2(overlap * numberOfVertices / (cliqueSize1 * cliqueSizes2[shiftedCliqueIndex2]));
+                overlapCounts[shiftedCliqueIndex2] = 0;
+            }
+        }
+    }
+
+    return entropy1 + entropy2 - 2.0 * mutualInformation;
+}
+
+bool PartitionDistanceCalculator::isRandErrorBelow(const Partition& partition1,
+                                           const Partition& partition2,
+                                           double threshold) {
+    // Either both bounds are below the threshold or none is
+    int64_t mostDisagreeingPairs = boundDisagreeingPairs(partition1, partition2, threshold).second;
+    return randErrorForDisagreeingPairs(mostDisagreeingPairs, partition1.numberOfVertices()) < threshold;
+}
+
+double randErrorForDisagreeingPairs(int64_t numberOfDisagreeingPairs,
+                                    int64_t numberOfVertices) {
+    if (numberOfVertices < 2) {
+        return 0.0;
+    }
+    int64_t numberOfPairs = numberOfVertices * (numberOfVertices - 1) / 2;
+    return static_cast<double>(numberOfDisagreeingPairs) / numberOfPairs;
+}
+
+namespace {
+PartitionDistanceCalculator& partitionDistanceCalculatorOfThisThread() {
+    thread_local PartitionDistanceCalculator calculator;
+    return calculator;
+}
+}  // namespace
+
+double randError(const std::vector<int>& cliqueIndexForVertex1,
+                 const std::vector<int>& cliqueIndexForVertex2) {
+    return partitionDistanceCalculatorOfThisThread().randError(cliqueIndexForVertex1, cliqueIndexForVertex2);
+}
+
+int64_t numberOfDisagreeingPairs(const std::vector<int>& cliqueIndexForVertex1,
+                                 const std::vector<int>& cliqueIndexForVertex2) {
+    return partitionDistanceCalculatorOfThisThread().numberOfDisagreeingPairs(cliqueIndexForVertex1, cliqueIndexForVertex2);
+}
+
+std::pair<int64_t, int64_t> boundDisagreeingPairs(const Partition& partition1,
+                                                  const Partition& partition2,
+                                                  double threshold) {
+    return partitionDistanceCalculatorOfThisThread().boundDisagreeingPairs(partition1, partition2, threshold);
+}
+
+double variationOfInformation(const std::vector<int>& cliqueIndexForVertex1,
+                              const std::vector<int>& cliqueIndexForVertex2) {
+    return partitionDistanceCalculatorOfThisThread().variationOfInformation(cliqueIndexForVertex1, cliqueIndexForVertex2);
+}
+
+bool isRandErrorBelow(const Partition& partition1,
+                      const Partition& partition2,
+                      double threshold) {
+    return partitionDistanceCalculatorOfThisThread().isRandErrorBelow(partition1, partition2, threshold);
+}
+
+CondensedDistanceMatrix::CondensedDistanceMatrix(int numberOfPartitions)
+    : numberOfPartitions(numberOfPartitions), distances(static_cast<size_t>(numberOfPartitions) * (numberOfPartitions - 1) / 2) {
+}
+
+int CondensedDistanceMatrix::size() const {
+    return numberOfPartitions;
+}
+
+float CondensedDistanceMatrix::operator()(int index1, int index2) const {
+    return distances[pairIndex(index1, index2)];
+}
+
+float& CondensedDistanceMatrix::operator()(int index1, int index2) {
+    return distances[pairIndex(index1, index2)];
+}
+
+size_t CondensedDistanceMatrix::pairIndex(int index1, int index2) const {
+    size_t row = std::min(index1, index2);
+    size_t column = std::max(index1, index2);
+
+    // Rows 0 to row - 1 hold (n - 1) + (n - 2) + ... + (n - row) pairs
+    return row * numberOfPartitions - row * (row + 1) / 2 + (column - row - 1);
+}
+
+CondensedDistanceMatrix computeDistanceMatrix(const std::vector<std::vector<int>>& partitions,
+                                              Metric metric,
+                                              int numberOfThreads) {
+    int numberOfPartitions = partitions.size();
+    CondensedDistanceMatrix distances(numberOfPartitions);
+
+    auto computeRow = [&](int i) {
+        for (int j = i + 1; j < numberOfPartitions; ++j) {
             switch (metric) {
                 case Metric::RAND_ERROR:
-                    distance = andres::RandError(solutions[i].begin(),
-                                                 solutions[i].end(),
-                                                 solutions[j].begin())
-                                   .error();
+                    distances(i, j) = static_cast<float>(randError(partitions[i], partitions[j]));
                     break;
                 case Metric::VI:
-                    distance = andres::VariationOfInformation(solutions[i].begin(),
-                                                              solutions[i].end(),
-                                                              solutions[j].begin())
-                                   .value();
+                    distances(i, j) = static_cast<float>(variationOfInformation(partitions[i], partitions[j]));
                     break;
             }
-            distances[i][j] = static_cast<float>(distance);
         }
-    }
+    };
+
+    // The later rows are shorter, so the rows are paired up from both ends to give every task about the same number of pairs
+    int numberOfTasks = (numberOfPartitions + 1) / 2;
+    auto computeRows = [&](int task) {
+        computeRow(task);
+        if (numberOfPartitions - 1 - task != task) {
+            computeRow(numberOfPartitions - 1 - task);
+        }
+    };
+
+    ThreadPool::shared().parallelFor(numberOfTasks, computeRows, numberOfThreads);
 
     return distances;
-}
\ No newline at end of file
+}
@@ -0,0 +1,39 @@
+#include "SolutionHashSet.h"
+
+#include <unordered_map>
+
+bool SolutionHashSet::contains(const SolutionWithValueAndIndexLookup& solution) const {
+    auto [first, last] = solutionsByHash.equal_range(solution.hash);
+
+    for (auto it = first; it != last; ++it) {
+        if (*it->second == solution) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SolutionHashSet::insert(const SharedSolution& solution) {
+    if (contains(*solution)) {
+        return false;
+    }
+
+    solutionsByHash.emplace(solution->hash, solution);
+    return true;
+}
+
+void SolutionHashSet::erase(const SharedSolution& solution) {
+    auto [first, last] = solutionsByHash.equal_range(solution->hash);
+
+    for (auto it = first; it != last; ++it) {
+        if (it->second == solution) {
+            solutionsByHash.erase(it);
+            return;
+        }
+    }
+}
+
+size_t SolutionHashSet::size() const {
+    return solutionsByHash.size();
+}
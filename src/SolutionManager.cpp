@@ -1,71 +1,170 @@
 #include "SolutionManager.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <utility>
+
+#include "PartitionDistances.h"
+
+/**
+ * Pools with at least this many solutions compare a candidate with the solutions that share a band of its sketch first.
+ * Without exact similarity checks, the other solutions are taken as dissimilar, which is faster for large pools,
+ * but misses a similar solution with a small probability.
+ */
+int SolutionManager::minimalPoolSizeForSketches = 64;
+bool SolutionManager::exactSimilarityChecks = true;
+
+SolutionManager::CandidateComparisons& SolutionManager::comparisonsWith(const SolutionWithValueAndIndexLookup& candidateSolution) const {
+    if (candidateComparisons.candidate != &candidateSolution || candidateComparisons.hash != candidateSolution.hash) {
+        int64_t numberOfVertices = candidateSolution.partition.numberOfVertices();
+        int64_t numberOfPairs = numberOfVertices * (numberOfVertices - 1) / 2;
+
+        candidateComparisons.candidate = &candidateSolution;
+        candidateComparisons.hash = candidateSolution.hash;
+        candidateComparisons.disagreeingPairs.assign(solutions.size(), {0, numberOfPairs});
+        candidateComparisons.sketch = CoMembershipSketch(candidateSolution.partition, sampledPairs);
+    }
+    return candidateComparisons;
+}
 
-#include "partition-comparison.hxx"
+bool SolutionManager::isSimilarToPoolSolution(const SolutionWithValueAndIndexLookup& candidateSolution,
+                                              int index) const {
+    CandidateComparisons& comparisons = comparisonsWith(candidateSolution);
+    auto& [leastDisagreeingPairs, mostDisagreeingPairs] = comparisons.disagreeingPairs[index];
+
+    int numberOfVertices = candidateSolution.partition.numberOfVertices();
+    auto isBelowThreshold = [&](int64_t numberOfDisagreeingPairs) {
+        return randErrorForDisagreeingPairs(numberOfDisagreeingPairs, numberOfVertices) < similarityThreshold;
+    };
+    auto isDecided = [&]() {
+        return isBelowThreshold(mostDisagreeingPairs) || !isBelowThreshold(leastDisagreeingPairs);
+    };
+
+    // The number of disagreeing pairs is a metric, so the distances to the other solutions of the pool bound it
+    for (int otherIndex = 0; otherIndex < solutions.size() && !isDecided(); ++otherIndex) {
+        const auto& [leastToOther, mostToOther] = comparisons.disagreeingPairs[otherIndex];
+        int64_t betweenPoolSolutions = disagreeingPairsInPool[otherIndex][index];
+        leastDisagreeingPairs = std::max({leastDisagreeingPairs, leastToOther - betweenPoolSolutions, betweenPoolSolutions - mostToOther});
+        mostDisagreeingPairs = std::min(mostDisagreeingPairs, mostToOther + betweenPoolSolutions);
+    }
 
-bool SolutionManager::isSimilar(const SolutionWithValueAndIndexLookup& solution1,
-                                const SolutionWithValueAndIndexLookup& solution2) const {
-    double distance = andres::RandError(
-                          solution1.cliqueIndexForVertex.begin(),
-                          solution1.cliqueIndexForVertex.end(),
-                          solution2.cliqueIndexForVertex.begin())
-                          .error();
+    // Most solutions are clearly dissimilar, which is known long before the exact distance
+    if (!isDecided()) {
+        auto [least, most] = boundDisagreeingPairs(candidateSolution.partition, solutions[index]->partition, similarityThreshold);
+        leastDisagreeingPairs = std::max(leastDisagreeingPairs, least);
+        mostDisagreeingPairs = std::min(mostDisagreeingPairs, most);
+    }
 
-    return distance < similarityThreshold;
+    return isBelowThreshold(mostDisagreeingPairs);
 }
 
-int SolutionManager::findInsertPosition(const SolutionWithValueAndIndexLookup& candidateSolution) const {
-    // Using std::find_if to find the first solution with lower value
-    auto it = std::find_if(solutions.begin(), solutions.end(),
-                           [&candidateSolution](const SolutionWithValueAndIndexLookup& solution) {
-                               return candidateSolution.value > solution.value;
-                           });
+int64_t SolutionManager::exactDisagreeingPairsWithPoolSolution(const SolutionWithValueAndIndexLookup& candidateSolution,
+                                                               int index) const {
+    auto& [leastDisagreeingPairs, mostDisagreeingPairs] = comparisonsWith(candidateSolution).disagreeingPairs[index];
+    if (leastDisagreeingPairs != mostDisagreeingPairs) {
+        leastDisagreeingPairs = mostDisagreeingPairs = numberOfDisagreeingPairs(candidateSolution.cliqueIndexForVertexLookup(),
+                                                                                solutions[index]->cliqueIndexForVertexLookup());
+    }
+    return leastDisagreeingPairs;
+}
+
+std::vector<int> SolutionManager::comparisonOrder(const SolutionWithValueAndIndexLookup& candidateSolution,
+                                                  int first,
+                                                  int last) const {
+    std::vector<int> order;
+    if (solutions.size() < minimalPoolSizeForSketches) {
+        for (int i = first; i < last; i++) {
+            order.push_back(i);
+        }
+        return order;
+    }
 
-    return std::distance(solutions.begin(), it);
+    // The solutions that share a band are the likely similar ones, and the closest sketches come first among them
+    const CoMembershipSketch& candidateSketch = comparisonsWith(candidateSolution).sketch;
+    std::vector<std::pair<std::pair<bool, int>, int>> keyedOrder;
+    for (int i = first; i < last; i++) {
+        bool sharesBand = candidateSketch.sharesBand(sketches[i]);
+        if (sharesBand || exactSimilarityChecks) {
+            keyedOrder.push_back({{!sharesBand, candidateSketch.hammingDistance(sketches[i])}, i});
+        }
+    }
+    std::sort(keyedOrder.begin(), keyedOrder.end());
+
+    for (const auto& [key, index] : keyedOrder) {
+        order.push_back(index);
+    }
+    return order;
+}
+
+void SolutionManager::erasePoolSolution(int index) {
+    solutions.erase(index);
+    sketches.erase(sketches.begin() + index);
+
+    disagreeingPairsInPool.erase(disagreeingPairsInPool.begin() + index);
+    for (auto& row : disagreeingPairsInPool) {
+        row.erase(row.begin() + index);
+    }
+
+    if (candidateComparisons.candidate != nullptr) {
+        candidateComparisons.disagreeingPairs.erase(candidateComparisons.disagreeingPairs.begin() + index);
+    }
 }
 
 void SolutionManager::removeSimilarSolutionsWithLowerValue(const SolutionWithValueAndIndexLookup& solution,
                                                            int startIndex) {
-    for (int i = startIndex + 1; i < solutions.size(); i++) {
-        if (isSimilar(solution, solutions[i])) {
-            solutions.erase(solutions.begin() + i);
-            i--;  // Adjust index after removal
+    std::vector<int> similarSolutionIndices;
+    for (int i : comparisonOrder(solution, startIndex, solutions.size())) {
+        if (isSimilarToPoolSolution(solution, i)) {
+            similarSolutionIndices.push_back(i);
         }
     }
+
+    // From the back, so that the indices of the remaining similar solutions don't change
+    std::sort(similarSolutionIndices.rbegin(), similarSolutionIndices.rend());
+    for (int i : similarSolutionIndices) {
+        erasePoolSolution(i);
+    }
 }
 
 SolutionManager::SolutionManager(float similarityThreshold, int maxCapacity)
-    : similarityThreshold(similarityThreshold), maxCapacity(maxCapacity) {
+    : solutions(maxCapacity), similarityThreshold(similarityThreshold) {
 }
 
-void SolutionManager::initialize(const std::vector<SolutionWithValueAndIndexLookup>& initialSolutions) {
-    solutions.clear();
+void SolutionManager::initialize(std::vector<SharedSolution> initialSolutions) {
+    // The pool sorts the solutions by value and keeps up to maxCapacity of them
+    solutions = ElitePool(solutions.capacity());
+    for (auto& solution : initialSolutions) {
+        solutions.tryInsert(std::move(solution));
+    }
 
-    // Sort solutions by value and take up to maxCapacity
-    solutions = initialSolutions;
-    std::sort(solutions.begin(), solutions.end(),
-              [](const SolutionWithValueAndIndexLookup& a, const SolutionWithValueAndIndexLookup& b) {
-                  return a.value > b.value;
-              });
+    sampledPairs = CoMembershipSketch::samplePairs(solutions.empty() ? 0 : solutions.best()->partition.numberOfVertices());
+    sketches.clear();
+    for (const auto& solution : solutions) {
+        sketches.emplace_back(solution->partition, sampledPairs);
+    }
 
-    if (solutions.size() > maxCapacity) {
-        solutions.resize(maxCapacity);
+    disagreeingPairsInPool.assign(solutions.size(), std::vector<int64_t>(solutions.size(), 0));
+    for (int i = 0; i < solutions.size(); ++i) {
+        for (int j = i + 1; j < solutions.size(); ++j) {
+            disagreeingPairsInPool[i][j] = disagreeingPairsInPool[j][i] =
+                numberOfDisagreeingPairs(solutions[i]->cliqueIndexForVertexLookup(), solutions[j]->cliqueIndexForVertexLookup());
+        }
     }
+    candidateComparisons.candidate = nullptr;
 }
 
 size_t SolutionManager::count() const {
     return solutions.size();
 }
 
-SolutionWithValueAndIndexLookup SolutionManager::getSolution(int index) const {
+const SharedSolution& SolutionManager::getSolution(int index) const {
     return solutions[index];
 }
 
 bool SolutionManager::similarSolutionExists(const SolutionWithValueAndIndexLookup& candidateSolution) const {
-    for (const auto& existingSolution : solutions) {
-        if (isSimilar(candidateSolution, existingSolution)) {
+    for (int i : comparisonOrder(candidateSolution, 0, solutions.size())) {
+        if (isSimilarToPoolSolution(candidateSolution, i)) {
             return true;
         }
     }
@@ -74,10 +173,10 @@ bool SolutionManager::similarSolutionExists(const SolutionWithValueAndIndexLooku
 }
 
 bool SolutionManager::existsSimilarSolutionWithHigherValue(const SolutionWithValueAndIndexLookup& candidateSolution) const {
-    int insertPosition = findInsertPosition(candidateSolution);
+    int insertPosition = solutions.insertPosition(candidateSolution.value);
 
-    for (int i = 0; i < insertPosition; i++) {
-        if (isSimilar(candidateSolution, solutions[i])) {
+    for (int i : comparisonOrder(candidateSolution, 0, insertPosition)) {
+        if (isSimilarToPoolSolution(candidateSolution, i)) {
             return true;
         }
     }
@@ -85,48 +184,66 @@ bool SolutionManager::existsSimilarSolutionWithHigherValue(const SolutionWithVal
     return false;
 }
 
-void SolutionManager::tryAddSolution(const SolutionWithValueAndIndexLookup& candidateSolution,
+void SolutionManager::tryAddSolution(SharedSolution candidateSolution,
                                      double elapsedTime) {
     // Find insertion position
-    int insertPosition = findInsertPosition(candidateSolution);
+    int insertPosition = solutions.insertPosition(candidateSolution->value);
 
     // Check if the solution is better than the worst solution
-    if (insertPosition >= maxCapacity) {
+    if (insertPosition >= solutions.capacity()) {
         // std::cout << "Solution is worse than the worst solution" << std::endl;
         return;
     }
 
     // Check if similar solutions with higher values exist
-    if (existsSimilarSolutionWithHigherValue(candidateSolution)) {
+    if (existsSimilarSolutionWithHigherValue(*candidateSolution)) {
         // std::cout << "Similar solution with higher value exists" << std::endl;
         return;
     }
 
-    // Insert the solution at the right position
-    solutions.insert(solutions.begin() + insertPosition, candidateSolution);
+    // Remove similar solutions with lower values, which are all behind the insert position
+    removeSimilarSolutionsWithLowerValue(*candidateSolution, insertPosition);
 
     // Print value, if new best solution
     if (insertPosition == 0) {
-        std::cout << "New best: " << candidateSolution.value << "    Time: " << elapsedTime << " seconds." << std::endl;
+        std::cout << "New best: " << candidateSolution->value << "    Time: " << elapsedTime << " seconds." << std::endl;
     }
 
-    // Remove similar solutions with lower values
-    removeSimilarSolutionsWithLowerValue(candidateSolution, insertPosition);
+    if (!solutions.accepts(*candidateSolution)) {
+        candidateComparisons.candidate = nullptr;
+        return;
+    }
+
+    // The worst solution is dropped if the pool is full
+    if (solutions.full()) {
+        erasePoolSolution(solutions.size() - 1);
+    }
 
-    // Truncate to max capacity if needed
-    if (solutions.size() > maxCapacity) {
-        solutions.resize(maxCapacity);
+    // The distances to the remaining solutions are the new row of the distance matrix
+    std::vector<int64_t> disagreeingPairsWithCandidate(solutions.size() + 1, 0);
+    for (int i = 0; i < solutions.size(); i++) {
+        disagreeingPairsWithCandidate[i < insertPosition ? i : i + 1] = exactDisagreeingPairsWithPoolSolution(*candidateSolution, i);
     }
+    for (int i = 0; i < solutions.size(); i++) {
+        disagreeingPairsInPool[i].insert(disagreeingPairsInPool[i].begin() + insertPosition, disagreeingPairsWithCandidate[i < insertPosition ? i : i + 1]);
+    }
+    disagreeingPairsInPool.insert(disagreeingPairsInPool.begin() + insertPosition, std::move(disagreeingPairsWithCandidate));
+
+    sketches.insert(sketches.begin() + insertPosition, comparisonsWith(*candidateSolution).sketch);
+
+    // Insert the solution at the right position
+    solutions.tryInsert(std::move(candidateSolution));
+    candidateComparisons.candidate = nullptr;
 }
 
-SolutionWithValueAndIndexLookup SolutionManager::getBestSolution() const {
-    return solutions[0];
+const SharedSolution& SolutionManager::getBestSolution() const {
+    return solutions.best();
 }
 
-SolutionWithValueAndIndexLookup SolutionManager::getWorstSolution() const {
-    return solutions.back();
+const SharedSolution& SolutionManager::getWorstSolution() const {
+    return solutions.worst();
 }
 
-const std::vector<SolutionWithValueAndIndexLookup>& SolutionManager::getAllSolutions() const {
-    return solutions;
+const std::vector<SharedSolution>& SolutionManager::getAllSolutions() const {
+    return solutions.solutions();
 }
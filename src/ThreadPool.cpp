@@ -0,0 +1,117 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+ThreadPool::ThreadPool(int numberOfThreads) {
+    reserve(numberOfThreads);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+int ThreadPool::defaultNumberOfThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+int ThreadPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return workers.size();
+}
+
+void ThreadPool::reserve(int numberOfThreads) {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (workers.size() < numberOfThreads) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(int count,
+                             const std::function<void(int)>& func,
+                             int numberOfThreads) {
+    int numberOfHelpers = std::min(numberOfThreads, count) - 1;
+
+    if (numberOfHelpers <= 0) {
+        for (int i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    reserve(numberOfHelpers);
+
+    // The state is shared with the helpers, as a helper might only be started after all the work is done.
+    // Such a helper doesn't find any index left and returns without touching func.
+    struct SharedState {
+        std::atomic<int> nextIndex{0};
+        int numberOfOpenIndices;
+        std::mutex mutex;
+        std::condition_variable allDone;
+    };
+    auto state = std::make_shared<SharedState>();
+    state->numberOfOpenIndices = count;
+
+    auto work = [state, &func, count]() {
+        int i;
+        while ((i = state->nextIndex.fetch_add(1)) < count) {
+            func(i);
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (--state->numberOfOpenIndices == 0) {
+                state->allDone.notify_all();
+            }
+        }
+    };
+
+    for (int i = 0; i < numberOfHelpers; ++i) {
+        enqueue(work);
+    }
+
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->allDone.wait(lock, [&state]() { return state->numberOfOpenIndices == 0; });
+}
@@ -1,12 +1,13 @@
 #include <filesystem>
 #include <iostream>
-#include <list>
 #include <string>
 #include <vector>
 
 #include "DiversePoolSearch.h"
 #include "FileReading.h"
 #include "FixedSetSearch.h"
+#include "Partition.h"
+#include "PortionScheduler.h"
 #include "SimulatedAnnealing.h"
 #include "Timer.h"
 #include "utils.h"
@@ -30,9 +31,17 @@ int main() {
     int timeLimitInSeconds = 20 * 60;  // 20 minutes
 
     // --- Variables to Store Results ---
-    std::vector<std::list<int>> bestPartition;
+    Partition bestPartition;
     double duration = 0;
 
+    // --- Search Variants (see their definitions in FixedSetSearch.cpp and DiversePoolSearch.cpp) ---
+    FixedSetSearch::contractFixedCliques = false;
+    FixedSetSearch::annealOnlyFreeVertices = false;
+    FixedSetSearch::pipelinedIterations = false;
+    FixedSetSearch::portionSchedulingStrategy = PortionScheduler::ROUND_ROBIN;
+    DiversePoolSearch::parallelPoolSweep = false;
+    DiversePoolSearch::numberOfSpeculativeReheats = 1;
+
     // --- Choose Search Method ---
     bool useDiversePoolSearch = false;
     if (useDiversePoolSearch) {
@@ -61,11 +70,17 @@ int main() {
                 initialTemperature,
                 batchSizeScaleFactor);
         });
+
+        for (const auto& [portion, statistics] : FixedSetSearch::lastPortionStatistics) {
+            std::cout << "Portion " << portion << ": " << statistics.numberOfIterations << " iterations, "
+                      << statistics.numberOfNewBestSolutions << " new best, " << statistics.totalImprovement << " improvement in "
+                      << statistics.seconds << " seconds." << std::endl;
+        }
     }
 
     // --- Output Results ---
     std::cout << "Duration: " << duration << " s" << std::endl;
-    std::cout << "Value for Best Partition: " << utils::valueForPartition(bestPartition, weights) << std::endl;
+    std::cout << "Value for Best Partition: " << utils::valueForPartitionInParallel(bestPartition, weights) << std::endl;
 
     return 0;
 }